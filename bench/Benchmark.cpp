@@ -0,0 +1,216 @@
+// Benchmark.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include "Benchmark.hpp"
+#include "Stopwatch.hpp"
+
+
+
+namespace
+{
+    std::string quoteJson(const std::string& s)
+    {
+        std::string quoted = "\"";
+
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+            {
+                quoted += '\\';
+            }
+
+            quoted += c;
+        }
+
+        return quoted + "\"";
+    }
+
+
+    void writeTable(std::ostream& out, const std::vector<BenchmarkResult>& results)
+    {
+        out << std::left << std::setw(14) << "ENGINE" << std::setw(18) << "BENCHMARK"
+            << std::right << std::setw(9) << "OPS" << std::setw(6) << "REPS"
+            << std::setw(12) << "MIN" << std::setw(12) << "MEDIAN" << std::setw(12) << "MEAN"
+            << std::setw(12) << "P90" << std::setw(12) << "P99" << std::setw(12) << "MAX"
+            << std::setw(12) << "NSEC/OP" << std::endl;
+
+        for (const BenchmarkResult& result : results)
+        {
+            out << std::left << std::setw(14) << result.engine
+                << std::setw(18) << result.benchmark
+                << std::right << std::setw(9) << result.operationCount
+                << std::setw(6) << result.durations.size()
+                << std::fixed << std::setprecision(0)
+                << std::setw(12) << result.minimum()
+                << std::setw(12) << result.median()
+                << std::setw(12) << result.mean()
+                << std::setw(12) << result.percentile(90)
+                << std::setw(12) << result.percentile(99)
+                << std::setw(12) << result.maximum()
+                << std::setprecision(1)
+                << std::setw(12) << result.nanosecondsPerOperation() << std::endl;
+        }
+
+        out << std::endl;
+        out << "All times are in microseconds, except NSEC/OP, which is the median" << std::endl;
+        out << "time divided among the operations, in nanoseconds." << std::endl;
+    }
+
+
+    void writeCsv(std::ostream& out, const std::vector<BenchmarkResult>& results)
+    {
+        out << "engine,benchmark,operations,repetitions,min_usec,median_usec,mean_usec,"
+            << "p90_usec,p99_usec,max_usec,median_nsec_per_op" << std::endl;
+
+        out << std::fixed << std::setprecision(3);
+
+        for (const BenchmarkResult& result : results)
+        {
+            out << result.engine << ',' << result.benchmark << ','
+                << result.operationCount << ',' << result.durations.size() << ','
+                << result.minimum() << ',' << result.median() << ',' << result.mean() << ','
+                << result.percentile(90) << ',' << result.percentile(99) << ','
+                << result.maximum() << ',' << result.nanosecondsPerOperation() << std::endl;
+        }
+    }
+
+
+    void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results)
+    {
+        out << std::fixed << std::setprecision(3);
+        out << "[" << std::endl;
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const BenchmarkResult& result = results[i];
+
+            out << "  {\"engine\":" << quoteJson(result.engine)
+                << ",\"benchmark\":" << quoteJson(result.benchmark)
+                << ",\"operations\":" << result.operationCount
+                << ",\"repetitions\":" << result.durations.size()
+                << ",\"min_usec\":" << result.minimum()
+                << ",\"median_usec\":" << result.median()
+                << ",\"mean_usec\":" << result.mean()
+                << ",\"p90_usec\":" << result.percentile(90)
+                << ",\"p99_usec\":" << result.percentile(99)
+                << ",\"max_usec\":" << result.maximum()
+                << ",\"median_nsec_per_op\":" << result.nanosecondsPerOperation()
+                << ",\"durations_usec\":[";
+
+            for (std::size_t j = 0; j < result.durations.size(); ++j)
+            {
+                out << (j > 0 ? "," : "") << result.durations[j];
+            }
+
+            out << "]}" << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+
+        out << "]" << std::endl;
+    }
+}
+
+
+
+double BenchmarkResult::minimum() const
+{
+    return durations.empty() ? 0.0 : durations.front();
+}
+
+
+double BenchmarkResult::median() const
+{
+    return percentile(50);
+}
+
+
+double BenchmarkResult::mean() const
+{
+    if (durations.empty())
+    {
+        return 0.0;
+    }
+
+    return std::accumulate(durations.begin(), durations.end(), 0.0) / durations.size();
+}
+
+
+double BenchmarkResult::maximum() const
+{
+    return durations.empty() ? 0.0 : durations.back();
+}
+
+
+double BenchmarkResult::percentile(double p) const
+{
+    if (durations.empty())
+    {
+        return 0.0;
+    }
+
+    double rank = p / 100.0 * (durations.size() - 1);
+    std::size_t below = static_cast<std::size_t>(std::floor(rank));
+    std::size_t above = static_cast<std::size_t>(std::ceil(rank));
+
+    return durations[below] + (durations[above] - durations[below]) * (rank - below);
+}
+
+
+double BenchmarkResult::nanosecondsPerOperation() const
+{
+    return operationCount == 0 ? 0.0 : median() * 1000.0 / operationCount;
+}
+
+
+
+BenchmarkResult measure(
+    const std::string& engine, const std::string& benchmark, std::size_t operationCount,
+    const BenchmarkOptions& options, const std::function<void()>& operation,
+    const std::function<void()>& setup)
+{
+    BenchmarkResult result{engine, benchmark, operationCount, {}};
+    Stopwatch stopwatch;
+
+    for (unsigned int i = 0; i < options.warmupCount + options.repetitionCount; ++i)
+    {
+        if (setup)
+        {
+            setup();
+        }
+
+        stopwatch.start();
+        operation();
+        stopwatch.stop();
+
+        if (i >= options.warmupCount)
+        {
+            result.durations.push_back(stopwatch.lastDuration());
+        }
+    }
+
+    std::sort(result.durations.begin(), result.durations.end());
+    return result;
+}
+
+
+void writeResults(
+    std::ostream& out, const std::vector<BenchmarkResult>& results, BenchmarkFormat format)
+{
+    if (format == BenchmarkFormat::Csv)
+    {
+        writeCsv(out, results);
+    }
+    else if (format == BenchmarkFormat::Json)
+    {
+        writeJson(out, results);
+    }
+    else
+    {
+        writeTable(out, results);
+    }
+}
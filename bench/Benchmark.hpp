@@ -0,0 +1,91 @@
+// Benchmark.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Tools for measuring how long operations take, repeatably enough to
+// compare one implementation (or one version of an implementation) with
+// another.
+//
+// A measurement runs an operation a number of times without timing it,
+// as a warmup (so that caches are filled and memory is allocated), then a
+// number of times more, timing each.  Rather than a single duration, it
+// reports on the distribution of the timed ones: their minimum, median,
+// mean, 90th and 99th percentiles, and maximum.  The median is the one to
+// compare, since unlike the mean, it isn't thrown off by the occasional
+// repetition that was interrupted by something else on the machine.
+//
+// A batch of measurements can be written as a table for people to read,
+// or as CSV or JSON for other programs.
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+
+struct BenchmarkResult
+{
+    // The word set the operation was measured on, and what was measured.
+    std::string engine;
+    std::string benchmark;
+
+    // The number of individual operations (such as lookups) done by each
+    // repetition, so that the time per operation can be reported.
+    std::size_t operationCount;
+
+    // The duration of each timed repetition, in microseconds, from
+    // shortest to longest.
+    std::vector<double> durations;
+
+    double minimum() const;
+    double median() const;
+    double mean() const;
+    double maximum() const;
+
+    // percentile() returns the given percentile (from 0 to 100) of the
+    // durations, interpolating between the two nearest when it falls
+    // between them.
+    double percentile(double p) const;
+
+    // nanosecondsPerOperation() returns the median duration divided among
+    // the operations.
+    double nanosecondsPerOperation() const;
+};
+
+
+struct BenchmarkOptions
+{
+    unsigned int warmupCount;
+    unsigned int repetitionCount;
+};
+
+
+// measure() times the operation as described above.  The setup function,
+// if given, is called (untimed) before each run of the operation, warmups
+// included, for operations that need a fresh start each time.
+BenchmarkResult measure(
+    const std::string& engine, const std::string& benchmark, std::size_t operationCount,
+    const BenchmarkOptions& options, const std::function<void()>& operation,
+    const std::function<void()>& setup = nullptr);
+
+
+enum class BenchmarkFormat
+{
+    Table,
+    Csv,
+    Json
+};
+
+
+void writeResults(
+    std::ostream& out, const std::vector<BenchmarkResult>& results, BenchmarkFormat format);
+
+
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,390 @@
+// benchmain.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Benchmarks every kind of word set that the shell offers (see
+// WordSetTypes.hpp), measuring each of these on each of them (see
+// Benchmark.hpp):
+//
+// * add: adding every word in the word file to an empty set, one add()
+//   at a time
+// * addAll: adding the same words through a single addAll(), as the shell
+//   does when it loads a word file
+// * contains-hit: looking up every word in the word file
+// * contains-miss: looking up every word in the text that isn't in the
+//   word file
+// * findSuggestions: finding suggestions for each of those
+// * run: checking the whole text with a SpellChecker that has no
+//   listeners, so that every suggestion is found but none are displayed
+//
+// It's run as:
+//
+//     a.out.bench [options] [engine ...]
+//
+// where the engines are named as they are in the shell (quoted, if they
+// contain spaces, such as "HASH PRODUCT"); every engine is measured if
+// none are named.  The options are:
+//
+// * --warmup=N: the number of untimed runs before the timed ones (1)
+// * --repetitions=N: the number of timed runs (5)
+// * --format=table|csv|json: how the results are written (table)
+// * --words=PATH: the word file (wordset.txt)
+// * --text=PATH: the text (biginput.txt)
+// * --limit=N: use only the first N words of the word file (all of them)
+//
+// The results are written to standard output; progress is reported on
+// standard error.  Some engines (such as LIST and HASH ZERO) are far
+// slower than the others on the whole word file, by design; --limit
+// makes comparing them practical.
+//
+// EMBEDDED always holds every word in wordset.txt, which is compiled into
+// the program, so its lookups wouldn't miss when --limit or --words leave
+// some of those words out.  It's skipped in that case.
+//
+// Unlike the other programs, it's built with optimization, along with its
+// own optimized copies of the core and provided code (see CMakeLists.txt),
+// so that what it measures is what the code can do rather than what an
+// unoptimized build of it can.
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Benchmark.hpp"
+#include "EmbeddedSet.hpp"
+#include "Set.hpp"
+#include "SpellChecker.hpp"
+#include "TextFileReader.hpp"
+#include "WordChecker.hpp"
+#include "WordSetLoader.hpp"
+#include "WordSetTypes.hpp"
+
+
+namespace
+{
+    const std::string DEFAULT_WORD_FILE_PATH = "wordset.txt";
+
+
+    struct BenchOptions
+    {
+        BenchmarkOptions benchmarkOptions;
+        BenchmarkFormat format;
+        std::string wordFilePath;
+        std::string textFilePath;
+        std::size_t wordLimit;
+        std::vector<std::string> engines;
+    };
+
+
+    class BenchException
+    {
+    public:
+        BenchException(const std::string& reason)
+            : reason_{reason}
+        {
+        }
+
+        std::string reason() const
+        {
+            return reason_;
+        }
+
+    private:
+        std::string reason_;
+    };
+
+
+    unsigned int makeCount(const std::string& option, const std::string& value)
+    {
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+        {
+            throw BenchException{"Invalid option: " + option};
+        }
+
+        return std::stoul(value);
+    }
+
+
+    BenchmarkFormat makeFormat(const std::string& option, const std::string& value)
+    {
+        if (value == "table")
+        {
+            return BenchmarkFormat::Table;
+        }
+        else if (value == "csv")
+        {
+            return BenchmarkFormat::Csv;
+        }
+        else if (value == "json")
+        {
+            return BenchmarkFormat::Json;
+        }
+        else
+        {
+            throw BenchException{"Invalid option: " + option};
+        }
+    }
+
+
+    BenchOptions parseOptions(int argc, char** argv)
+    {
+        BenchOptions options{
+            {1, 5}, BenchmarkFormat::Table, DEFAULT_WORD_FILE_PATH, "biginput.txt", 0, {}};
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string option = argv[i];
+
+            if (option.substr(0, 2) != "--")
+            {
+                if (!makeWordSet(option))
+                {
+                    throw BenchException{"Invalid search structure type: " + option};
+                }
+
+                options.engines.push_back(option);
+                continue;
+            }
+
+            std::string name = option.substr(0, option.find('='));
+            std::string value =
+                name.length() < option.length() ? option.substr(name.length() + 1) : "";
+
+            if (name == "--warmup")
+            {
+                options.benchmarkOptions.warmupCount = makeCount(option, value);
+            }
+            else if (name == "--repetitions")
+            {
+                options.benchmarkOptions.repetitionCount = makeCount(option, value);
+
+                if (options.benchmarkOptions.repetitionCount == 0)
+                {
+                    throw BenchException{"Invalid option: " + option};
+                }
+            }
+            else if (name == "--format")
+            {
+                options.format = makeFormat(option, value);
+            }
+            else if (name == "--words" && !value.empty())
+            {
+                options.wordFilePath = value;
+            }
+            else if (name == "--text" && !value.empty())
+            {
+                options.textFilePath = value;
+            }
+            else if (name == "--limit")
+            {
+                options.wordLimit = makeCount(option, value);
+            }
+            else
+            {
+                throw BenchException{"Invalid option: " + option};
+            }
+        }
+
+        if (options.engines.empty())
+        {
+            options.engines = wordSetTypes();
+        }
+
+        return options;
+    }
+
+
+    void requireFileExists(const std::string& filePath)
+    {
+        if (!std::ifstream{filePath}.is_open())
+        {
+            throw BenchException{"Cannot open file: " + filePath};
+        }
+    }
+
+
+    std::vector<std::string> readTextWords(const std::string& textFilePath)
+    {
+        std::vector<std::string> words;
+        TextFileReader reader{textFilePath};
+
+        for (; !reader.noMoreWords(); reader.advanceToNextWord())
+        {
+            words.push_back(reader.currentWord());
+        }
+
+        return words;
+    }
+
+
+    // The results of lookups are added up here, so that the compiler
+    // can't decide that the lookups are unnecessary.
+    volatile std::size_t sink;
+
+
+    void benchmarkEngine(
+        const std::string& engine, const BenchOptions& options,
+        const std::vector<std::string>& words, bool allEmbeddedWords, std::size_t textWordCount,
+        const std::vector<std::string>& missingWords, std::vector<BenchmarkResult>& results)
+    {
+        const BenchmarkOptions& benchmarkOptions = options.benchmarkOptions;
+
+        auto report = [&](BenchmarkResult result)
+        {
+            std::cerr << "  " << result.benchmark << ": median "
+                      << std::fixed << std::setprecision(0) << result.median()
+                      << " usec" << std::endl;
+
+            results.push_back(std::move(result));
+        };
+
+        std::unique_ptr<Set<std::string>> set = makeWordSet(engine);
+
+        if (!set->isImplemented())
+        {
+            std::cerr << "Skipping " << engine << ", which is not implemented" << std::endl;
+            return;
+        }
+
+        if (!allEmbeddedWords && dynamic_cast<EmbeddedSet*>(set.get()) != nullptr)
+        {
+            std::cerr << "Skipping " << engine << ", which always holds every word in "
+                      << DEFAULT_WORD_FILE_PATH << std::endl;
+            return;
+        }
+
+        std::cerr << "Benchmarking " << engine << " ..." << std::endl;
+
+        // Each of these ends by asking for the set's size, so that sets
+        // that put off some of the work of adding until they're next read
+        // (such as CompiledSet) are measured doing all of it.
+        report(measure(
+            engine, "add", words.size(), benchmarkOptions,
+            [&]()
+            {
+                for (const std::string& word : words)
+                {
+                    set->add(word);
+                }
+
+                sink = sink + set->size();
+            },
+            [&]() { set = makeWordSet(engine); }));
+
+        report(measure(
+            engine, "addAll", words.size(), benchmarkOptions,
+            [&]()
+            {
+                set->addAll(words.data(), words.size());
+                sink = sink + set->size();
+            },
+            [&]() { set = makeWordSet(engine); }));
+
+        set = makeWordSet(engine);
+        set->addAll(words.data(), words.size());
+
+        auto lookUp = [&](const std::vector<std::string>& lookups)
+        {
+            std::size_t found = 0;
+
+            for (const std::string& word : lookups)
+            {
+                found += set->contains(word) ? 1 : 0;
+            }
+
+            sink = sink + found;
+        };
+
+        report(measure(
+            engine, "contains-hit", words.size(), benchmarkOptions,
+            [&]() { lookUp(words); }));
+
+        report(measure(
+            engine, "contains-miss", missingWords.size(), benchmarkOptions,
+            [&]() { lookUp(missingWords); }));
+
+        WordChecker wordChecker{*set};
+
+        report(measure(
+            engine, "findSuggestions", missingWords.size(), benchmarkOptions,
+            [&]()
+            {
+                std::size_t suggestionCount = 0;
+
+                for (const std::string& word : missingWords)
+                {
+                    suggestionCount += wordChecker.findSuggestions(word).size();
+                }
+
+                sink = sink + suggestionCount;
+            }));
+
+        report(measure(
+            engine, "run", textWordCount, benchmarkOptions,
+            [&]()
+            {
+                SpellChecker spellChecker;
+                TextFileReader reader{options.textFilePath};
+                spellChecker.run(wordChecker, reader);
+            }));
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        BenchOptions options = parseOptions(argc, argv);
+
+        requireFileExists(options.wordFilePath);
+        requireFileExists(options.textFilePath);
+
+        std::vector<std::string> words = WordSetLoader{}.readWords(options.wordFilePath);
+        bool allEmbeddedWords = options.wordFilePath == DEFAULT_WORD_FILE_PATH;
+
+        if (options.wordLimit > 0 && options.wordLimit < words.size())
+        {
+            words.resize(options.wordLimit);
+            allEmbeddedWords = false;
+        }
+
+        std::unordered_set<std::string> dictionary{words.begin(), words.end()};
+        std::vector<std::string> textWords = readTextWords(options.textFilePath);
+        std::vector<std::string> missingWords;
+
+        for (const std::string& word : textWords)
+        {
+            if (dictionary.count(word) == 0)
+            {
+                missingWords.push_back(word);
+            }
+        }
+
+        std::cerr << "Using " << words.size() << " words from " << options.wordFilePath
+                  << " and " << missingWords.size() << " missing words from "
+                  << options.textFilePath << std::endl;
+
+        std::vector<BenchmarkResult> results;
+
+        for (const std::string& engine : options.engines)
+        {
+            benchmarkEngine(
+                engine, options, words, allEmbeddedWords,
+                textWords.size(), missingWords, results);
+        }
+
+        writeResults(std::cout, results, options.format);
+    }
+    catch (BenchException& e)
+    {
+        std::cerr << "ERROR: " << e.reason() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -17,6 +17,7 @@
 #define AVLSET_HPP
 
 #include "Set.hpp"
+#include "TreeSearch.hpp"
 #include <algorithm>
 #include <iostream>
 
@@ -67,6 +68,16 @@ public:
     virtual unsigned int size() const;
 
 
+    // containsBatch() answers contains() for each of the count elements,
+    // storing the answers into out.  A group of searches descends the tree
+    // together (see TreeSearch.hpp), so that their cache misses overlap.
+    virtual void containsBatch(const T* elements, unsigned int count, bool* out) const;
+
+
+    // The number of searches that containsBatch() keeps in flight at once.
+    static constexpr unsigned int BATCH_GROUP_SIZE = 16;
+
+
 private:
 
 	struct Node
@@ -284,6 +295,13 @@ bool AVLSet<T>::contains(const T& element) const
 }
 
 
+template <typename T>
+void AVLSet<T>::containsBatch(const T* elements, unsigned int count, bool* out) const
+{
+	containsBatchInTree<BATCH_GROUP_SIZE>(head, elements, count, out);
+}
+
+
 template <typename T>
 unsigned int AVLSet<T>::size() const
 {
@@ -0,0 +1,361 @@
+// CompiledSet.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+#include <vector>
+#include "CompiledSet.hpp"
+#include "StringHashing.hpp"
+
+
+
+struct CompiledSet::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t wordCount;
+    std::uint32_t bucketCount;
+    std::uint32_t stringBytes;
+    std::uint64_t checksum;
+};
+
+
+struct CompiledSet::Entry
+{
+    std::uint32_t hash;
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+
+
+namespace
+{
+    const char MAGIC[8] = {'W', 'O', 'R', 'D', 'S', 'E', 'T', '\0'};
+
+
+    // The checksum is the 64-bit FNV-1a hash of the bytes.
+    std::uint64_t checksum(std::string_view bytes)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+
+        for (char c : bytes)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+
+    // imageSize() returns the number of bytes in an image with the given
+    // numbers of words, buckets, and bytes of string data.
+    std::uint64_t imageSize(
+        std::size_t headerSize, std::size_t entrySize,
+        std::uint64_t wordCount, std::uint64_t bucketCount, std::uint64_t stringBytes)
+    {
+        return headerSize
+            + (bucketCount + 1) * sizeof(std::uint32_t)
+            + wordCount * entrySize
+            + wordCount * sizeof(std::uint32_t)
+            + stringBytes;
+    }
+}
+
+
+
+CompiledSet::FormatException::FormatException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+std::string CompiledSet::FormatException::reason() const
+{
+    return reason_;
+}
+
+
+
+CompiledSet::CompiledSet()
+    : header{nullptr}, buckets{nullptr}, entries{nullptr}, order{nullptr}, strings{nullptr},
+      hasPending{false}
+{
+    build(nullptr, 0);
+}
+
+
+bool CompiledSet::isCompiled(const std::string& filePath)
+{
+    std::ifstream file{filePath, std::ios::binary};
+
+    char magic[sizeof(MAGIC)];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+
+void CompiledSet::open(const std::string& filePath, bool verifyChecksum)
+{
+    std::unique_ptr<MappedFile> newFile = std::make_unique<MappedFile>(filePath);
+
+    if (!newFile->isOpen())
+    {
+        throw FormatException{"Cannot open compiled dictionary: " + filePath};
+    }
+
+    std::string_view contents = newFile->contents();
+
+    if (contents.length() < sizeof(Header)
+        || std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw FormatException{"Not a compiled dictionary: " + filePath};
+    }
+
+    const Header* newHeader = reinterpret_cast<const Header*>(contents.data());
+
+    if (newHeader->version != FORMAT_VERSION)
+    {
+        throw FormatException{"Unsupported compiled dictionary version: " + filePath};
+    }
+
+    std::uint64_t expectedSize = imageSize(
+        sizeof(Header), sizeof(Entry),
+        newHeader->wordCount, newHeader->bucketCount, newHeader->stringBytes);
+
+    if (newHeader->bucketCount == 0 || expectedSize != contents.length())
+    {
+        throw FormatException{"Compiled dictionary is damaged: " + filePath};
+    }
+
+    // Nothing beyond the header is read here, so that opening a dictionary
+    // doesn't fault in its pages; each lookup checks the indexes and offsets
+    // it reads instead (see contains() and checkedEntry()).
+    if (verifyChecksum && checksum(contents.substr(sizeof(Header))) != newHeader->checksum)
+    {
+        throw FormatException{"Compiled dictionary is damaged: " + filePath};
+    }
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+    file = std::move(newFile);
+    useImage(contents);
+
+    pending.clear();
+    hasPending.store(false, std::memory_order_release);
+}
+
+
+bool CompiledSet::save(const std::string& filePath) const
+{
+    buildPending();
+
+    std::ofstream output{filePath, std::ios::binary | std::ios::trunc};
+    output.write(image.data(), image.length());
+    return static_cast<bool>(output);
+}
+
+
+bool CompiledSet::isImplemented() const
+{
+    return true;
+}
+
+
+void CompiledSet::add(const std::string& element)
+{
+    addAll(&element, 1);
+}
+
+
+void CompiledSet::addAll(const std::string* elements, unsigned int count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    pending.insert(pending.end(), elements, elements + count);
+    hasPending.store(true, std::memory_order_release);
+}
+
+
+bool CompiledSet::contains(const std::string& element) const
+{
+    buildPending();
+
+    std::uint32_t hash = hashStringAsProduct(element);
+    std::uint32_t bucket = hash % header->bucketCount;
+    std::uint32_t first = buckets[bucket];
+    std::uint32_t last = buckets[bucket + 1];
+
+    if (first > last || last > header->wordCount)
+    {
+        throw FormatException{"Compiled dictionary is damaged"};
+    }
+
+    for (std::uint32_t i = first; i < last; ++i)
+    {
+        const Entry& entry = checkedEntry(i);
+
+        if (entry.hash == hash
+            && entry.length == element.length()
+            && std::memcmp(strings + entry.offset, element.data(), entry.length) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+unsigned int CompiledSet::size() const
+{
+    buildPending();
+
+    return header->wordCount;
+}
+
+
+std::string_view CompiledSet::word(unsigned int index) const
+{
+    buildPending();
+
+    const Entry& entry = checkedEntry(order[index]);
+    return std::string_view{strings + entry.offset, entry.length};
+}
+
+
+const CompiledSet::Entry& CompiledSet::checkedEntry(std::uint32_t index) const
+{
+    if (index >= header->wordCount)
+    {
+        throw FormatException{"Compiled dictionary is damaged"};
+    }
+
+    const Entry& entry = entries[index];
+
+    if (std::uint64_t{entry.offset} + entry.length > header->stringBytes)
+    {
+        throw FormatException{"Compiled dictionary is damaged"};
+    }
+
+    return entry;
+}
+
+
+void CompiledSet::buildPending() const
+{
+    if (!hasPending.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{buildingMutex};
+
+    if (!hasPending.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    std::vector<std::string_view> words;
+    words.reserve(header->wordCount + pending.size());
+
+    for (std::uint32_t i = 0; i < header->wordCount; ++i)
+    {
+        const Entry& entry = checkedEntry(order[i]);
+        words.emplace_back(strings + entry.offset, entry.length);
+    }
+
+    words.insert(words.end(), pending.begin(), pending.end());
+
+    build(words.data(), words.size());
+
+    pending.clear();
+    hasPending.store(false, std::memory_order_release);
+}
+
+
+void CompiledSet::build(const std::string_view* words, unsigned int count) const
+{
+    std::unordered_set<std::string_view> seen;
+    std::vector<std::string_view> unique;
+    std::vector<std::uint32_t> hashes;
+    std::uint64_t stringBytes = 0;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (seen.insert(words[i]).second)
+        {
+            unique.push_back(words[i]);
+            hashes.push_back(hashStringAsProduct(std::string{words[i]}));
+            stringBytes += words[i].length();
+        }
+    }
+
+    std::uint32_t bucketCount = unique.size() + unique.size() / 4 + 1;
+
+    std::string newBuffer(
+        imageSize(sizeof(Header), sizeof(Entry), unique.size(), bucketCount, stringBytes),
+        '\0');
+
+    Header* newHeader = reinterpret_cast<Header*>(&newBuffer[0]);
+    std::uint32_t* newBuckets = reinterpret_cast<std::uint32_t*>(newHeader + 1);
+    Entry* newEntries = reinterpret_cast<Entry*>(newBuckets + bucketCount + 1);
+    std::uint32_t* newOrder = reinterpret_cast<std::uint32_t*>(newEntries + unique.size());
+    char* newStrings = reinterpret_cast<char*>(newOrder + unique.size());
+
+    std::memcpy(newHeader->magic, MAGIC, sizeof(MAGIC));
+    newHeader->version = FORMAT_VERSION;
+    newHeader->wordCount = unique.size();
+    newHeader->bucketCount = bucketCount;
+    newHeader->stringBytes = stringBytes;
+
+    // The entries are sorted by bucket with a counting sort: count the
+    // words in each bucket, turn the counts into starting indexes, then
+    // place each word at the next index in its bucket.
+    for (std::uint32_t hash : hashes)
+    {
+        ++newBuckets[hash % bucketCount + 1];
+    }
+
+    for (std::uint32_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        newBuckets[bucket + 1] += newBuckets[bucket];
+    }
+
+    std::vector<std::uint32_t> nextIndexes(newBuckets, newBuckets + bucketCount);
+    std::uint32_t offset = 0;
+
+    for (std::size_t i = 0; i < unique.size(); ++i)
+    {
+        std::uint32_t index = nextIndexes[hashes[i] % bucketCount]++;
+        newEntries[index] = Entry{hashes[i], offset, std::uint32_t(unique[i].length())};
+        newOrder[i] = index;
+        std::memcpy(newStrings + offset, unique[i].data(), unique[i].length());
+        offset += unique[i].length();
+    }
+
+    newHeader->checksum = checksum(std::string_view{newBuffer}.substr(sizeof(Header)));
+
+    // The words may have pointed into the old image, so it's only replaced
+    // once the new one is complete.
+    buffer = std::move(newBuffer);
+    file.reset();
+    useImage(buffer);
+}
+
+
+void CompiledSet::useImage(std::string_view newImage) const
+{
+    image = newImage;
+    header = reinterpret_cast<const Header*>(image.data());
+    buckets = reinterpret_cast<const std::uint32_t*>(header + 1);
+    entries = reinterpret_cast<const Entry*>(buckets + header->bucketCount + 1);
+    order = reinterpret_cast<const std::uint32_t*>(entries + header->wordCount);
+    strings = reinterpret_cast<const char*>(order + header->wordCount);
+}
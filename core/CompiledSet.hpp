@@ -0,0 +1,178 @@
+// CompiledSet.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A CompiledSet is a read-mostly Set<std::string> stored as a single
+// contiguous image in a binary format that can be saved to a file and
+// later used in place by mapping the file into memory.  Opening a
+// compiled dictionary involves no parsing and no allocation beyond the
+// mapping, so the operating system loads its pages on demand and shares
+// them among every process that opens the same file.
+//
+// The image is a hash table whose chains are laid out contiguously:
+//
+// * A header: the magic bytes "WORDSET", the format version, the number
+//   of words and buckets, the size of the string data, and a checksum of
+//   everything that follows the header.
+// * For each bucket, the index of its first entry, followed by one more
+//   index marking the end of the last bucket.
+// * For each word, an entry holding its hash, and the offset and length
+//   of its characters in the string data.
+// * For each word, in the order the words were added, the index of its
+//   entry.
+// * The string data.
+//
+// Numbers are stored in the native byte order, so a compiled dictionary
+// is only usable on machines with the same byte order as the one that
+// compiled it (on any other, its version would not be recognized).
+//
+// Words added to a CompiledSet are held aside until the set is next read
+// (by contains(), size(), word(), or save()), at which point the image is
+// rebuilt once with all of them.  A series of add() calls followed by
+// lookups therefore costs one rebuild, not one per word; interleaving adds
+// with lookups costs one rebuild per lookup that follows an add.
+
+#ifndef COMPILEDSET_HPP
+#define COMPILEDSET_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.hpp"
+#include "Set.hpp"
+
+
+
+class CompiledSet : public Set<std::string>
+{
+public:
+    // The version of the format written by save().  Files with any other
+    // version are rejected by open().
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+
+    // A FormatException is thrown by open() when the given file isn't a
+    // compiled dictionary, or is one that's been damaged.  Since open()
+    // checks little more than the header, damage can also be found later,
+    // in which case contains() or word() throws one.
+    class FormatException
+    {
+    public:
+        FormatException(const std::string& reason);
+
+        std::string reason() const;
+
+    private:
+        std::string reason_;
+    };
+
+
+public:
+    // Initializes an empty CompiledSet.
+    CompiledSet();
+
+    CompiledSet(const CompiledSet&) = delete;
+    CompiledSet& operator=(const CompiledSet&) = delete;
+
+
+    // isCompiled() returns true if the given file begins the way that a
+    // compiled dictionary does.  It doesn't check the rest of the file.
+    static bool isCompiled(const std::string& filePath);
+
+
+    // open() replaces the contents of this set with the compiled
+    // dictionary in the given file, which is mapped into memory and used
+    // in place.  If the file isn't a valid compiled dictionary, a
+    // FormatException is thrown and the set is left unchanged.
+    //
+    // Only the header and the size of the file are checked, so that
+    // opening reads nothing else and the rest of the file is loaded on
+    // demand; the indexes and offsets are checked as lookups read them.
+    // The whole file is checked against its checksum if verifyChecksum is
+    // true.
+    void open(const std::string& filePath, bool verifyChecksum = false);
+
+
+    // save() writes this set's image to the given file, returning false
+    // if the file could not be written.  Any words added since the image
+    // was last built are built into it first.
+    bool save(const std::string& filePath) const;
+
+
+    virtual bool isImplemented() const;
+
+
+    // add() adds an element to the set.  It only holds the element aside,
+    // so it takes constant time (amortized); the image is rebuilt when the
+    // set is next read.
+    virtual void add(const std::string& element);
+
+
+    // addAll() adds the count elements to the set, holding them aside in
+    // the same way as add(); this takes linear time in count.
+    virtual void addAll(const std::string* elements, unsigned int count);
+
+
+    // contains() returns true if the given element is in the set.  This
+    // function runs in constant time (assuming the words hash well), once
+    // any words added since the last lookup have been built into the
+    // image, which takes linear time in the total number of words.
+    virtual bool contains(const std::string& element) const;
+
+
+    virtual unsigned int size() const;
+
+
+    // word() returns the word at the given index, which must be less than
+    // size().  The words are indexed in the order they were added.
+    std::string_view word(unsigned int index) const;
+
+
+private:
+    struct Header;
+    struct Entry;
+
+    // The image is rebuilt when added words are first read, which can
+    // happen in a const member function, so everything that describes it
+    // is mutable.
+
+    // The image is either held in memory or mapped from a file.
+    mutable std::string buffer;
+    mutable std::unique_ptr<MappedFile> file;
+    mutable std::string_view image;
+
+    // These point into the image.
+    mutable const Header* header;
+    mutable const std::uint32_t* buckets;
+    mutable const Entry* entries;
+    mutable const std::uint32_t* order;
+    mutable const char* strings;
+
+    // The words added since the image was last built.  hasPending is set
+    // whenever there are any, so that reads can check for them without
+    // locking; buildingMutex keeps concurrent reads from building them
+    // into the image at the same time.
+    mutable std::vector<std::string> pending;
+    mutable std::atomic<bool> hasPending;
+    mutable std::mutex buildingMutex;
+
+private:
+    // buildPending() rebuilds the image to include the pending words, if
+    // there are any.
+    void buildPending() const;
+    void build(const std::string_view* words, unsigned int count) const;
+
+    // checkedEntry() returns the entry at the given index, throwing a
+    // FormatException if it or its string lies outside of the image.
+    const Entry& checkedEntry(std::uint32_t index) const;
+    void useImage(std::string_view newImage) const;
+};
+
+
+
+#endif // COMPILEDSET_HPP
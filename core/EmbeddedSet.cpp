@@ -0,0 +1,64 @@
+// EmbeddedSet.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "EmbeddedSet.hpp"
+
+
+
+bool EmbeddedSet::isImplemented() const
+{
+    return true;
+}
+
+
+void EmbeddedSet::add(const std::string& element)
+{
+    if (!embeddedContains(element))
+    {
+        addedWords.insert(element);
+    }
+}
+
+
+bool EmbeddedSet::contains(const std::string& element) const
+{
+    return embeddedContains(element)
+        || (!addedWords.empty() && addedWords.count(element) != 0);
+}
+
+
+unsigned int EmbeddedSet::size() const
+{
+    return dictionary.wordCount + addedWords.size();
+}
+
+
+unsigned int EmbeddedSet::embeddedSize()
+{
+    return dictionary.wordCount;
+}
+
+
+std::string_view EmbeddedSet::embeddedWord(unsigned int index)
+{
+    std::uint32_t begin = dictionary.wordOffsets[index];
+    std::uint32_t end = dictionary.wordOffsets[index + 1];
+    return std::string_view{dictionary.keys + begin, end - begin};
+}
+
+
+bool EmbeddedSet::embeddedContains(std::string_view word)
+{
+    if (dictionary.wordCount == 0)
+    {
+        return false;
+    }
+
+    std::uint32_t bucket = hash(word, 0) % dictionary.bucketCount;
+    std::uint32_t displacement = dictionary.displacements[bucket];
+    std::uint32_t slot = dictionary.slots[hash(word, displacement) % dictionary.slotCount];
+
+    return slot != EMPTY_SLOT && embeddedWord(slot) == word;
+}
@@ -0,0 +1,110 @@
+// EmbeddedSet.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// An EmbeddedSet is a Set<std::string> whose words are compiled into the
+// program itself.  When the program is built, a generator (see
+// dictgen/dictgen.cpp) turns wordset.txt into a C++ source file holding
+// the words and a perfect hash table over them as constexpr data, which
+// the compiler places in read-only memory.  So an EmbeddedSet needs no
+// dictionary file, takes no time to load, and its pages are shared by
+// every process running the program.
+//
+// The perfect hash table is built by "hash and displace": each word is
+// first hashed (with seed zero) into one of a number of buckets, and each
+// bucket is given a displacement, chosen when the table is generated, so
+// that hashing each word with its bucket's displacement as the seed puts
+// every word into a different slot.  Finding a word therefore takes two
+// hashes and one comparison.
+//
+// Words that aren't in the embedded dictionary can still be added; they
+// are kept separately, in an ordinary hash table.
+
+#ifndef EMBEDDEDSET_HPP
+#define EMBEDDEDSET_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "Set.hpp"
+
+
+
+class EmbeddedSet : public Set<std::string>
+{
+public:
+    // The value stored in a slot of the table that holds no word.
+    static constexpr std::uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+
+    // A Dictionary describes the generated data.  The words are stored
+    // back to back in keys, in the order they appeared in the word file,
+    // with word i found at [wordOffsets[i], wordOffsets[i + 1]).  Each slot
+    // holds the index of a word, or EMPTY_SLOT.
+    struct Dictionary
+    {
+        const char* keys;
+        const std::uint32_t* wordOffsets;
+        std::uint32_t wordCount;
+        const std::uint32_t* displacements;
+        std::uint32_t bucketCount;
+        const std::uint32_t* slots;
+        std::uint32_t slotCount;
+    };
+
+
+    // hash() is the hash function used to build and search the table: a
+    // 32-bit FNV-1a hash whose starting value is perturbed by the seed.
+    static constexpr std::uint32_t hash(std::string_view word, std::uint32_t seed)
+    {
+        std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+
+        for (char c : word)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+
+        return h;
+    }
+
+
+public:
+    virtual bool isImplemented() const;
+
+
+    // add() adds an element to the set.  Words in the embedded dictionary
+    // are already present; others are added to a separate hash table.
+    virtual void add(const std::string& element);
+
+
+    // contains() returns true if the given element is in the set.  This
+    // function runs in constant time.
+    virtual bool contains(const std::string& element) const;
+
+
+    virtual unsigned int size() const;
+
+
+    // embeddedSize() returns the number of words in the embedded
+    // dictionary, and embeddedWord() returns one of them, in the order
+    // they appeared in the word file.
+    static unsigned int embeddedSize();
+    static std::string_view embeddedWord(unsigned int index);
+
+
+private:
+    // The generated data, defined in the generated source file.
+    static const Dictionary dictionary;
+
+    std::unordered_set<std::string> addedWords;
+
+private:
+    static bool embeddedContains(std::string_view word);
+};
+
+
+
+#endif // EMBEDDEDSET_HPP
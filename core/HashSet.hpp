@@ -25,7 +25,10 @@
 
 #include <functional>
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include "Set.hpp"
 
 
@@ -38,6 +41,13 @@ public:
     // added to it.
     static constexpr unsigned int DEFAULT_CAPACITY = 10;
 
+    // The number of lookups that containsBatch() keeps in flight at once.
+    static constexpr unsigned int BATCH_GROUP_SIZE = 16;
+
+    // The number of elements that addAll() gives each thread it uses; with
+    // fewer elements than this, addAll() doesn't start any threads.
+    static constexpr unsigned int PARALLEL_ADD_MINIMUM = 16384;
+
     // A HashFunction 
     typedef std::function<unsigned int(const T&)> HashFunction;
 
@@ -78,12 +88,49 @@ public:
     virtual void add(const T& element);
 
 
+    // addAll() adds each of the count elements to the set.  Rather than
+    // resizing repeatedly, the array is resized once to the capacity that
+    // adding the elements one at a time would reach.  The elements are
+    // then hashed in parallel, and the array is split into ranges of
+    // buckets, each of which is filled by its own thread; since no two
+    // threads touch the same bucket, they don't need to synchronize.  The
+    // elements are grouped by range beforehand (with a counting sort), so
+    // each thread visits only the elements that belong in its buckets.
+    virtual void addAll(const T* elements, unsigned int count);
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function runs in constant time (with respect
     // to the number of elements, assuming a good hash function).
     virtual bool contains(const T& element) const;
 
 
+    // containsBatch() answers contains() for each of the count elements,
+    // storing the answers into out.  The elements are processed in groups:
+    // every element in a group is hashed and its bucket prefetched before
+    // any chain is walked, so the cache misses of independent lookups
+    // overlap rather than being paid one after another.
+    virtual void containsBatch(const T* elements, unsigned int count, bool* out) const;
+
+
+    // containsHashed() is like contains(), except that the caller has
+    // already computed the element's hash, which must agree with what
+    // this set's hash function would have returned.
+    bool containsHashed(unsigned int hash, const T& element) const;
+
+
+    // anyInBucket() returns true if any element in the bucket that the
+    // given hash maps to satisfies the given predicate.  This allows a
+    // caller to cheaply rule out an element before building it.
+    template <typename Predicate>
+    bool anyInBucket(unsigned int hash, Predicate predicate) const;
+
+
+    // hashesWith() returns true if this set's hash function is the given
+    // function.
+    bool hashesWith(unsigned int (*function)(const T&)) const;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const;
 
@@ -104,6 +151,7 @@ private:
 
     void copyHT(const HashSet& s);
     void destroyHT();
+    void rehash(unsigned int new_capacity);
 };
 
 
@@ -264,6 +312,144 @@ void HashSet<T>::add(const T& element)
 }
 
 
+template <typename T>
+void HashSet<T>::addAll(const T* elements, unsigned int count)
+{
+    unsigned int new_capacity = curr_capacity;
+
+    while (double(curr_size + count) / double(new_capacity) > 0.8)
+    {
+        new_capacity *= 2;
+    }
+
+    if (new_capacity != curr_capacity)
+    {
+        rehash(new_capacity);
+    }
+
+    unsigned int threadCount = std::min(
+        std::max(std::thread::hardware_concurrency(), 1u),
+        count / PARALLEL_ADD_MINIMUM);
+
+    if (threadCount <= 1)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            add(elements[i]);
+        }
+
+        return;
+    }
+
+    std::unique_ptr<unsigned int[]> indexes{new unsigned int[count]};
+    std::unique_ptr<unsigned int[]> added{new unsigned int[threadCount]{0}};
+    std::unique_ptr<std::thread[]> threads{new std::thread[threadCount]};
+
+    // Each thread is given a range of the elements to hash, then a range of
+    // the buckets to fill.  Bucket ranges begin at capacity * t / threadCount,
+    // so this is the thread whose range holds the given bucket.
+    auto bucketOwner =
+        [&](unsigned int index)
+        {
+            return static_cast<unsigned int>(
+                ((std::uint64_t{index} + 1) * threadCount - 1) / curr_capacity);
+        };
+
+    auto inParallel =
+        [&](auto task)
+        {
+            for (unsigned int t = 0; t < threadCount; ++t)
+            {
+                threads[t] = std::thread{task, t};
+            }
+
+            for (unsigned int t = 0; t < threadCount; ++t)
+            {
+                threads[t].join();
+            }
+        };
+
+    auto firstElement =
+        [&](unsigned int t)
+        {
+            return static_cast<unsigned int>(std::uint64_t{count} * t / threadCount);
+        };
+
+    // positions[t * threadCount + owner] starts as the number of thread t's
+    // elements that belong in owner's buckets.
+    std::unique_ptr<unsigned int[]> positions{
+        new unsigned int[threadCount * threadCount]{0}};
+
+    inParallel(
+        [&](unsigned int t)
+        {
+            for (unsigned int i = firstElement(t); i < firstElement(t + 1); ++i)
+            {
+                indexes[i] = hashFunction(elements[i]) % curr_capacity;
+                ++positions[t * threadCount + bucketOwner(indexes[i])];
+            }
+        });
+
+    // The counts become the positions where each thread's elements are
+    // placed, grouped by owner (and, within each owner's group, in the
+    // order they were given), so that each owner's elements are together.
+    std::unique_ptr<unsigned int[]> slices{new unsigned int[threadCount + 1]};
+    unsigned int position = 0;
+
+    for (unsigned int owner = 0; owner < threadCount; ++owner)
+    {
+        slices[owner] = position;
+
+        for (unsigned int t = 0; t < threadCount; ++t)
+        {
+            unsigned int ownedCount = positions[t * threadCount + owner];
+            positions[t * threadCount + owner] = position;
+            position += ownedCount;
+        }
+    }
+
+    slices[threadCount] = position;
+
+    std::unique_ptr<unsigned int[]> order{new unsigned int[count]};
+
+    inParallel(
+        [&](unsigned int t)
+        {
+            for (unsigned int i = firstElement(t); i < firstElement(t + 1); ++i)
+            {
+                order[positions[t * threadCount + bucketOwner(indexes[i])]++] = i;
+            }
+        });
+
+    inParallel(
+        [&](unsigned int t)
+        {
+            for (unsigned int j = slices[t]; j < slices[t + 1]; ++j)
+            {
+                unsigned int i = order[j];
+                unsigned int index = indexes[i];
+                Node* temp = hashtable[index];
+
+                while (temp && !(temp->key == elements[i]))
+                {
+                    temp = temp->next;
+                }
+
+                if (temp == nullptr)
+                {
+                    hashtable[index] = new Node{elements[i], hashtable[index]};
+                    ++added[t];
+                }
+            }
+        });
+
+    for (unsigned int t = 0; t < threadCount; ++t)
+    {
+        curr_size += added[t];
+    }
+}
+
+
 template <typename T>
 bool HashSet<T>::contains(const T& element) const
 {
@@ -295,6 +481,84 @@ bool HashSet<T>::contains(const T& element) const
 }
 
 
+template <typename T>
+void HashSet<T>::containsBatch(const T* elements, unsigned int count, bool* out) const
+{
+    unsigned int indexes[BATCH_GROUP_SIZE];
+
+    for (unsigned int start = 0; start < count; start += BATCH_GROUP_SIZE)
+    {
+        unsigned int groupSize = std::min(BATCH_GROUP_SIZE, count - start);
+
+        for (unsigned int i = 0; i < groupSize; ++i)
+        {
+            indexes[i] = hashFunction(elements[start + i]) % curr_capacity;
+            __builtin_prefetch(&hashtable[indexes[i]]);
+        }
+
+        for (unsigned int i = 0; i < groupSize; ++i)
+        {
+            __builtin_prefetch(hashtable[indexes[i]]);
+        }
+
+        for (unsigned int i = 0; i < groupSize; ++i)
+        {
+            Node* temp = hashtable[indexes[i]];
+
+            while (temp && !(temp->key == elements[start + i]))
+            {
+                temp = temp->next;
+            }
+
+            out[start + i] = temp != nullptr;
+        }
+    }
+}
+
+
+template <typename T>
+bool HashSet<T>::containsHashed(unsigned int hash, const T& element) const
+{
+    Node* temp = hashtable[hash % curr_capacity];
+
+    while (temp)
+    {
+        if (temp->key == element)
+        {
+            return true;
+        }
+
+        temp = temp->next;
+    }
+
+    return false;
+}
+
+
+template <typename T>
+template <typename Predicate>
+bool HashSet<T>::anyInBucket(unsigned int hash, Predicate predicate) const
+{
+    for (Node* temp = hashtable[hash % curr_capacity]; temp; temp = temp->next)
+    {
+        if (predicate(temp->key))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename T>
+bool HashSet<T>::hashesWith(unsigned int (*function)(const T&)) const
+{
+    auto target = hashFunction.template target<unsigned int(*)(const T&)>();
+    return target != nullptr && *target == function;
+}
+
+
 template <typename T>
 unsigned int HashSet<T>::size() const
 {
@@ -328,6 +592,31 @@ void HashSet<T>::copyHT(const HashSet& s)
 }
 
 
+template <typename T>
+void HashSet<T>::rehash(unsigned int new_capacity)
+{
+    Node** new_hashtable = new Node*[new_capacity]{nullptr};
+
+    for (unsigned int i = 0; i < curr_capacity; ++i)
+    {
+        Node* curr = hashtable[i];
+
+        while (curr != nullptr)
+        {
+            Node* next = curr->next;
+            unsigned int index = hashFunction(curr->key) % new_capacity;
+            curr->next = new_hashtable[index];
+            new_hashtable[index] = curr;
+            curr = next;
+        }
+    }
+
+    delete[] hashtable;
+    hashtable = new_hashtable;
+    curr_capacity = new_capacity;
+}
+
+
 template <typename T>
 void HashSet<T>::destroyHT()
 {
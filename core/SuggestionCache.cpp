@@ -0,0 +1,139 @@
+// SuggestionCache.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "SuggestionCache.hpp"
+
+
+
+SuggestionCache::SuggestionCache(unsigned int capacity)
+    : capacity_{capacity}, hand{0}, hitCount{0}, missCount{0}
+{
+    slots.reserve(capacity);
+    index.reserve(capacity);
+}
+
+
+std::vector<std::string> SuggestionCache::findSuggestions(
+    const WordChecker& wordChecker, const std::string& word)
+{
+    std::vector<std::string> suggestions;
+
+    if (!lookup(word, suggestions))
+    {
+        // The suggestions are computed without holding the lock, so other
+        // threads can keep hitting the cache in the meantime.  If two threads
+        // miss on the same word, both compute it and the second store wins.
+        suggestions = wordChecker.findSuggestions(word);
+        store(word, suggestions);
+    }
+
+    return suggestions;
+}
+
+
+bool SuggestionCache::lookup(const std::string& word, std::vector<std::string>& suggestions)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto found = index.find(word);
+
+    if (found == index.end())
+    {
+        ++missCount;
+        return false;
+    }
+
+    Entry& entry = slots[found->second];
+    entry.referenced = true;
+    suggestions = entry.suggestions;
+
+    ++hitCount;
+    return true;
+}
+
+
+void SuggestionCache::store(const std::string& word, const std::vector<std::string>& suggestions)
+{
+    if (capacity_ == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto found = index.find(word);
+
+    if (found != index.end())
+    {
+        Entry& entry = slots[found->second];
+        entry.suggestions = suggestions;
+        entry.referenced = true;
+        return;
+    }
+
+    if (slots.size() < capacity_)
+    {
+        index.emplace(word, slots.size());
+        slots.push_back(Entry{word, suggestions, false});
+        return;
+    }
+
+    // The cache is full, so sweep the hand around, giving each referenced
+    // entry a second chance, until we find one that hasn't been used since
+    // the hand last passed it.
+    while (slots[hand].referenced)
+    {
+        slots[hand].referenced = false;
+        hand = (hand + 1) % capacity_;
+    }
+
+    Entry& victim = slots[hand];
+    index.erase(victim.word);
+
+    victim.word = word;
+    victim.suggestions = suggestions;
+    victim.referenced = false;
+    index.emplace(word, hand);
+
+    hand = (hand + 1) % capacity_;
+}
+
+
+void SuggestionCache::clear()
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    slots.clear();
+    index.clear();
+    hand = 0;
+
+    hitCount = 0;
+    missCount = 0;
+}
+
+
+unsigned int SuggestionCache::capacity() const
+{
+    return capacity_;
+}
+
+
+unsigned int SuggestionCache::size() const
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    return slots.size();
+}
+
+
+unsigned long long SuggestionCache::hits() const
+{
+    return hitCount;
+}
+
+
+unsigned long long SuggestionCache::misses() const
+{
+    return missCount;
+}
@@ -0,0 +1,92 @@
+// SuggestionCache.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SuggestionCache remembers the suggestions that were generated for
+// recently-seen misspelled words, so that a word that is misspelled the
+// same way many times in a document only has its suggestions computed
+// once.  The cache is bounded; when it's full, entries are evicted using
+// the CLOCK algorithm (an approximation of least-recently-used that only
+// needs a "referenced" bit per entry).
+//
+// A SuggestionCache can safely be shared by multiple threads.
+
+#ifndef SUGGESTIONCACHE_HPP
+#define SUGGESTIONCACHE_HPP
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "WordChecker.hpp"
+
+
+
+class SuggestionCache
+{
+public:
+    // The default number of misspelled words whose suggestions are kept.
+    static constexpr unsigned int DEFAULT_CAPACITY = 4096;
+
+public:
+    // Initializes an empty SuggestionCache that will hold the suggestions
+    // for at most the given number of words.  A capacity of zero is legal
+    // and results in a cache that never stores anything.
+    SuggestionCache(unsigned int capacity = DEFAULT_CAPACITY);
+
+
+    // findSuggestions() returns the suggestions for the given word, asking
+    // the given WordChecker for them only if they're not already cached.
+    std::vector<std::string> findSuggestions(
+        const WordChecker& wordChecker, const std::string& word);
+
+
+    // lookup() copies the cached suggestions for the given word into
+    // suggestions and returns true, or returns false if the word is not
+    // in the cache.  Each call counts as either a hit or a miss.
+    bool lookup(const std::string& word, std::vector<std::string>& suggestions);
+
+
+    // store() caches the suggestions for the given word, evicting another
+    // word's suggestions if the cache is full.
+    void store(const std::string& word, const std::vector<std::string>& suggestions);
+
+
+    // clear() removes every entry and resets the hit and miss counters.
+    void clear();
+
+
+    unsigned int capacity() const;
+    unsigned int size() const;
+
+    unsigned long long hits() const;
+    unsigned long long misses() const;
+
+
+private:
+    struct Entry
+    {
+        std::string word;
+        std::vector<std::string> suggestions;
+        bool referenced;
+    };
+
+    const unsigned int capacity_;
+
+    mutable std::mutex mutex;
+
+    // The slots that the CLOCK hand sweeps over, along with an index from
+    // each cached word to its slot.
+    std::vector<Entry> slots;
+    std::unordered_map<std::string, unsigned int> index;
+    unsigned int hand;
+
+    std::atomic<unsigned long long> hitCount;
+    std::atomic<unsigned long long> missCount;
+};
+
+
+
+#endif // SUGGESTIONCACHE_HPP
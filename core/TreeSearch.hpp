@@ -0,0 +1,86 @@
+// TreeSearch.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A search shared by the binary search trees (BSTSet and AVLSet), which
+// looks up many elements at once.  Walking down a tree is a chain of
+// dependent loads, each of which can miss the cache, so rather than
+// searching for one element at a time, it walks a group of searches down
+// the tree together, one level per round, prefetching the node that each
+// will visit next.  The misses of the searches in a group then overlap,
+// instead of being paid one after another.
+//
+// The nodes need only have a key_value, and left and right pointers to
+// their children.
+
+#ifndef TREESEARCH_HPP
+#define TREESEARCH_HPP
+
+#include <algorithm>
+
+
+
+// containsBatchInTree() sets out[i] to whether elements[i] is in the tree
+// with the given root, for each of the count elements, keeping GroupSize
+// searches in flight at once.
+template <unsigned int GroupSize, typename Node, typename T>
+void containsBatchInTree(const Node* root, const T* elements, unsigned int count, bool* out)
+{
+    const Node* cursors[GroupSize];
+
+    for (unsigned int start = 0; start < count; start += GroupSize)
+    {
+        unsigned int groupSize = std::min(GroupSize, count - start);
+        unsigned int active = groupSize;
+
+        for (unsigned int i = 0; i < groupSize; ++i)
+        {
+            cursors[i] = root;
+            out[start + i] = false;
+        }
+
+        while (active > 0)
+        {
+            active = 0;
+
+            for (unsigned int i = 0; i < groupSize; ++i)
+            {
+                const Node* curr = cursors[i];
+
+                if (curr == nullptr)
+                {
+                    continue;
+                }
+
+                const T& element = elements[start + i];
+
+                if (curr->key_value == element)
+                {
+                    out[start + i] = true;
+                    curr = nullptr;
+                }
+                else if (curr->key_value > element)
+                {
+                    curr = curr->left;
+                }
+                else
+                {
+                    curr = curr->right;
+                }
+
+                if (curr != nullptr)
+                {
+                    __builtin_prefetch(curr);
+                    ++active;
+                }
+
+                cursors[i] = curr;
+            }
+        }
+    }
+}
+
+
+
+#endif // TREESEARCH_HPP
@@ -14,103 +14,528 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include "HashSet.hpp"
+#include "Normalization.hpp"
+#include "StringHashing.hpp"
 
 
 
+namespace
+{
+    // An Edit describes one candidate spelling in terms of how it differs
+    // from the original word, so that the candidate doesn't have to be
+    // built unless it's worth looking up: the candidate is the word with
+    // the width bytes at the given position replaced by the replacement.
+    // Swapping, inserting, deleting, and replacing characters are all
+    // edits of this kind, as is splitting a word into two, which is an
+    // insertion of a space.  A character can be more than one byte long
+    // when the word is UTF-8, so a replacement can be as long as two
+    // (swapped) characters.
+    struct Edit
+    {
+        unsigned int position;
+        unsigned int width;
+        unsigned int replacementLength;
+        char replacement[8];
+    };
+
+
+    Edit makeEdit(
+        unsigned int position, unsigned int width,
+        std::string_view first, std::string_view second = std::string_view{})
+    {
+        Edit edit;
+        edit.position = position;
+        edit.width = width;
+        edit.replacementLength = 0;
+
+        for (char c : first)
+        {
+            edit.replacement[edit.replacementLength++] = c;
+        }
+
+        for (char c : second)
+        {
+            edit.replacement[edit.replacementLength++] = c;
+        }
+
+        return edit;
+    }
+
+
+    Edit makeEdit(unsigned int position, unsigned int width, char letter)
+    {
+        Edit edit;
+        edit.position = position;
+        edit.width = width;
+        edit.replacementLength = 1;
+        edit.replacement[0] = letter;
+        return edit;
+    }
+
+
+    std::string applyEdit(const std::string& word, const Edit& edit)
+    {
+        std::string candidate;
+        candidate.reserve(word.size() - edit.width + edit.replacementLength);
+        candidate.append(word, 0, edit.position);
+        candidate.append(edit.replacement, edit.replacementLength);
+        candidate.append(word, edit.position + edit.width, std::string::npos);
+        return candidate;
+    }
+
+
+    unsigned int editedLength(const std::string& word, const Edit& edit)
+    {
+        return word.size() - edit.width + edit.replacementLength;
+    }
+
+
+    // editedCharAt() returns the character at the given position of the
+    // candidate that the edit produces from word, without building it.
+    char editedCharAt(const std::string& word, const Edit& edit, unsigned int position)
+    {
+        if (position < edit.position)
+        {
+            return word[position];
+        }
+        else if (position - edit.position < edit.replacementLength)
+        {
+            return edit.replacement[position - edit.position];
+        }
+        else
+        {
+            return word[position - edit.replacementLength + edit.width];
+        }
+    }
+
+
+    unsigned int code(char c)
+    {
+        return static_cast<unsigned int>(c);
+    }
+
+
+    // characterStarts() stores the offset of each character of the word
+    // into starts, followed by the word's length.  The word is treated as
+    // UTF-8, with any byte that isn't part of a valid sequence being a
+    // character of its own.
+    void characterStarts(const std::string& word, std::vector<unsigned int>& starts)
+    {
+        starts.clear();
+
+        std::size_t position = 0;
+
+        while (position < word.size())
+        {
+            starts.push_back(position);
+
+            char32_t codePoint;
+            std::size_t length;
+            decodeUtf8(word, position, codePoint, length);
+            position += length;
+        }
+
+        starts.push_back(word.size());
+    }
+
+
+    // A CandidateHasher derives what hashStringAsProduct() would return for
+    // a candidate spelling of a word from the hashes of the word's prefixes
+    // and the powers of the multiplier, all taken modulo 2^32 just as
+    // hashStringAsProduct() implicitly does.  Since the hash is a
+    // polynomial, replacing the bytes in [position, end) with others only
+    // exchanges the hash of the prefix ending at end for another.
+    class CandidateHasher
+    {
+    public:
+        explicit CandidateHasher(const std::string& word)
+            : n(word.size()), prefix(n + 1), power(n + sizeof(Edit::replacement) + 1)
+        {
+            prefix[0] = 0;
+            power[0] = 1;
+
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                prefix[i + 1] = prefix[i] * m + code(word[i]);
+            }
+
+            for (unsigned int i = 0; i + 1 < power.size(); ++i)
+            {
+                power[i + 1] = power[i] * m;
+            }
+        }
+
+
+        // replaced() returns the hash of the word with the bytes in
+        // [position, end) replaced by length bytes whose hash is given.
+        unsigned int replaced(
+            unsigned int position, unsigned int end, unsigned int hash, unsigned int length) const
+        {
+            return (prefix[position] * power[length] + hash - prefix[end]) * power[n - end]
+                + prefix[n];
+        }
+
+
+        // This version of replaced() replaces them with a single byte.
+        unsigned int replaced(unsigned int position, unsigned int end, char c) const
+        {
+            return (prefix[position] * m + code(c) - prefix[end]) * power[n - end] + prefix[n];
+        }
+
+
+        // swapped() returns the hash of the word with the bytes in
+        // [first, second) and [second, end) swapped.
+        unsigned int swapped(unsigned int first, unsigned int second, unsigned int end) const
+        {
+            unsigned int hash =
+                substring(second, end) * power[second - first] + substring(first, second);
+
+            return replaced(first, end, hash, end - first);
+        }
+
+
+        // of() returns the hash of the given text.
+        static unsigned int of(std::string_view text)
+        {
+            unsigned int hash = 0;
+
+            for (char c : text)
+            {
+                hash = hash * m + code(c);
+            }
+
+            return hash;
+        }
+
+    private:
+        static constexpr unsigned int m = PRODUCT_HASH_MULTIPLIER;
+
+        unsigned int n;
+        std::vector<unsigned int> prefix;
+        std::vector<unsigned int> power;
+
+        // substring() returns the hash of the bytes in [position, end).
+        unsigned int substring(unsigned int position, unsigned int end) const
+        {
+            return prefix[end] - prefix[position] * power[end - position];
+        }
+    };
+
+
+    // A NoHasher stands in for a CandidateHasher when the candidates'
+    // hashes aren't needed.
+    struct NoHasher
+    {
+        unsigned int replaced(unsigned int, unsigned int, unsigned int, unsigned int) const
+        {
+            return 0;
+        }
+
+        unsigned int replaced(unsigned int, unsigned int, char) const
+        {
+            return 0;
+        }
+
+        unsigned int swapped(unsigned int, unsigned int, unsigned int) const
+        {
+            return 0;
+        }
+
+        static unsigned int of(std::string_view)
+        {
+            return 0;
+        }
+    };
+
+
+    // forEachEdit() calls f(hash, edit) for every edit that produces a
+    // candidate spelling of a word of n characters, in the order in which
+    // they'd be suggested, inserting and replacing the ASCII letters (each
+    // a single byte) and then the others.  start(i) is the offset of the
+    // word's ith character, and start(n) is its length.  The candidate's
+    // hash is derived by the hasher, mostly from values that don't change
+    // from one letter to the next.
+    template <typename Start, typename Hasher, typename Function>
+    void forEachEdit(
+        const std::string& word, unsigned int n, Start start, const Hasher& hasher,
+        const std::string& asciiLetters, const std::vector<std::string>& otherLetters,
+        Function f)
+    {
+        auto character = [&](unsigned int i)
+        {
+            return std::string_view{word}.substr(start(i), start(i + 1) - start(i));
+        };
+
+        for (unsigned int i = 0; i + 1 < n; ++i)
+        {
+            f(hasher.swapped(start(i), start(i + 1), start(i + 2)),
+              makeEdit(start(i), start(i + 2) - start(i), character(i + 1), character(i)));
+        }
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            unsigned int position = start(i);
+
+            for (char letter : asciiLetters)
+            {
+                f(hasher.replaced(position, position, letter), makeEdit(position, 0, letter));
+            }
+
+            for (const std::string& letter : otherLetters)
+            {
+                f(hasher.replaced(position, position, Hasher::of(letter), letter.size()),
+                  makeEdit(position, 0, letter));
+            }
+        }
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            f(hasher.replaced(start(i), start(i + 1), 0, 0),
+              makeEdit(start(i), start(i + 1) - start(i), std::string_view{}));
+        }
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            unsigned int position = start(i);
+            unsigned int end = start(i + 1);
+
+            for (char letter : asciiLetters)
+            {
+                f(hasher.replaced(position, end, letter),
+                  makeEdit(position, end - position, letter));
+            }
+
+            for (const std::string& letter : otherLetters)
+            {
+                f(hasher.replaced(position, end, Hasher::of(letter), letter.size()),
+                  makeEdit(position, end - position, letter));
+            }
+        }
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            f(hasher.replaced(start(i), start(i), ' '), makeEdit(start(i), 0, ' '));
+        }
+    }
+
+
+    // This version of forEachEdit() finds where the word's characters
+    // start.  Every byte of an ASCII word is a character of its own, so
+    // there's nothing to find unless the word has bytes outside of ASCII.
+    template <typename Hasher, typename Function>
+    void forEachEdit(
+        const std::string& word, const Hasher& hasher,
+        const std::string& asciiLetters, const std::vector<std::string>& otherLetters,
+        Function f)
+    {
+        if (!containsNonAscii(word))
+        {
+            forEachEdit(
+                word, word.size(), [](unsigned int i) { return i; }, hasher,
+                asciiLetters, otherLetters, f);
+
+            return;
+        }
+
+        std::vector<unsigned int> starts;
+        characterStarts(word, starts);
+
+        forEachEdit(
+            word, starts.size() - 1, [&](unsigned int i) { return starts[i]; }, hasher,
+            asciiLetters, otherLetters, f);
+    }
+
+
+    void addSuggestion(std::vector<std::string>& suggest, std::string&& candidate)
+    {
+        if (std::find(suggest.begin(), suggest.end(), candidate) == suggest.end())
+        {
+            suggest.push_back(std::move(candidate));
+        }
+    }
+}
+
+
+
+const std::string WordChecker::letter = "QWERTYUIOPASDFGHJKLZXCVBNM";
 
 
 WordChecker::WordChecker(const Set<std::string>& words)
-    : words{words}
+    : WordChecker{words, nullptr}
 {
 }
 
 
-bool WordChecker::wordExists(const std::string& word) const
+WordChecker::WordChecker(const Set<std::string>& words, const WordPrefilter& prefilter)
+    : WordChecker{words, &prefilter}
 {
-    return words.contains(word);
 }
 
 
-std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
+WordChecker::WordChecker(const Set<std::string>& words, const WordPrefilter* prefilter)
+    : asciiLetters{letter}, words{words},
+      hashedWords{dynamic_cast<const HashSet<std::string>*>(&words)}, prefilter{prefilter}
 {
+    // The incremental hashing in findSuggestionsByHash() only agrees with
+    // the set if the set is hashing with hashStringAsProduct().
+    if (hashedWords != nullptr && !hashedWords->hashesWith(hashStringAsProduct))
+    {
+        hashedWords = nullptr;
+    }
+}
 
 
-    std::vector<std::string> suggest;
-    std::string letter = "QWERTYUIOPASDFGHJKLZXCVBNM";
-    std::string temp;
-
-   
-    //Swapping each adjacent pair of characters in the word.
-    for (unsigned int i = 0; i < word.size()-1; ++i)
-    {
-    	std::string temp2 = word;
-    	temp = word;
-    	temp2[i] = temp[i+1];
-    	temp2[i+1] = temp[i];
-    	if (wordExists(temp2) && (std::find(suggest.begin(), suggest.end(), temp2) == suggest.end()))
-    	{
-    		suggest.push_back(temp2);
-    	}
+void WordChecker::addLetters(const std::vector<std::string>& moreLetters)
+{
+    for (const std::string& moreLetter : moreLetters)
+    {
+        // A letter is a single character, which is at most four bytes
+        // long in UTF-8.
+        if (moreLetter.length() == 1)
+        {
+            if (asciiLetters.find(moreLetter[0]) == std::string::npos)
+            {
+                asciiLetters.push_back(moreLetter[0]);
+            }
+        }
+        else if (moreLetter.length() > 1 && moreLetter.length() <= 4
+            && std::find(otherLetters.begin(), otherLetters.end(), moreLetter)
+                == otherLetters.end())
+        {
+            otherLetters.push_back(moreLetter);
+        }
     }
+}
 
-    //In between each adjacent pair of characters in the word (also before the first character and after the last character), each letter from 'A' through 'Z' is inserted.
-    for (unsigned int i = 0; i<word.size(); ++i)
+
+bool WordChecker::wordExists(const std::string& word) const
+{
+    if (prefilter != nullptr && !prefilter->mayContain(word))
     {
-    	for (unsigned int j = 0; j<letter.size(); ++j)
-    	{
-    		temp = word;
-    		temp.insert(i, 1, letter[j]);
-    		if (wordExists(temp) && (std::find(suggest.begin(), suggest.end(), temp) == suggest.end()))
-    		{
-    			suggest.push_back(temp);
-    		}
+        return false;
+    }
 
-    	}
+    return words.contains(word);
+}
+
+
+std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
+{
+    if (hashedWords != nullptr)
+    {
+        return findSuggestionsByHash(word, std::numeric_limits<std::size_t>::max());
     }
 
-    //Deleting each character from the word.
-    for (unsigned int i = 0; i<word.size(); ++i)
+    // All of the candidate spellings are generated first and then looked
+    // up together with a single containsBatch() call, which lets the set
+    // overlap the memory accesses of the independent lookups.
+    std::vector<std::string> candidates = generateCandidates(word);
+
+    if (prefilter != nullptr)
     {
-    	temp = word;
-    	temp.erase(i, 1);
-    	
-    	if (wordExists(temp) && (std::find(suggest.begin(), suggest.end(), temp) == suggest.end()))
-    	{
-    		suggest.push_back(temp);
-    	}
-    		
+        candidates.erase(
+            std::remove_if(
+                candidates.begin(), candidates.end(),
+                [this](const std::string& candidate) { return !prefilter->mayContain(candidate); }),
+            candidates.end());
     }
 
-    //Replacing each character in the word with each letter from 'A' through 'Z'.
-    for (unsigned int i = 0; i<word.size(); ++i)
+    std::unique_ptr<bool[]> found{new bool[candidates.size()]};
+    words.containsBatch(candidates.data(), candidates.size(), found.get());
+
+    std::vector<std::string> suggest;
+
+    for (unsigned int i = 0; i < candidates.size(); ++i)
     {
-    	for (unsigned int j = 0; j<letter.size(); ++j)
+    	if (found[i])
     	{
-    		temp = word;
-    		temp[i] = letter[j];
-    		if (wordExists(temp) && (std::find(suggest.begin(), suggest.end(), temp) == suggest.end()))
-    		{
-    			suggest.push_back(temp);
-    		}
-
+    		addSuggestion(suggest, std::move(candidates[i]));
     	}
     }
 
-    //Splitting the word into a pair of words by adding a space in between each adjacent pair of characters in the word. 
-    //It should be noted that this will only generate a suggestion if both words in the pair are found in the word set.
-    for (unsigned int i = 0; i<word.size(); ++i)
+    return suggest;
+}
+
+
+std::vector<std::string> WordChecker::findSuggestions(
+    const std::string& word, std::size_t maxCount) const
+{
+    if (maxCount == 0)
     {
-    	for (unsigned int j = 0; j<letter.size(); ++j)
-    	{
-    		temp = word;
-    		temp.insert(i, " ");
-    		if (wordExists(temp) && (std::find(suggest.begin(), suggest.end(), temp) == suggest.end()))
-    		{
-    			suggest.push_back(temp);
-    		}
+        return std::vector<std::string>{};
+    }
+    else if (hashedWords != nullptr)
+    {
+        return findSuggestionsByHash(word, maxCount);
+    }
 
-    	}
+    // The candidates are looked up all at once, so there's no stopping
+    // early; the suggestions are just cut short.
+    std::vector<std::string> suggest = findSuggestions(word);
+
+    if (suggest.size() > maxCount)
+    {
+        suggest.resize(maxCount);
     }
+
+    return suggest;
+}
+
+
+std::vector<std::string> WordChecker::findSuggestionsByHash(
+    const std::string& word, std::size_t maxCount) const
+{
+    // Each candidate is described by its hash and the edit that produces
+    // it.  The candidate is only built and compared if the bucket its hash
+    // maps to holds at least one key of the candidate's length and it
+    // passes the prefilter (if any).  The bucket is checked first, since
+    // it's usually short and rules out nearly everything by itself.
+    std::vector<std::string> suggest;
+    forEachEdit(
+        word, CandidateHasher{word}, asciiLetters, otherLetters,
+        [&](unsigned int hash, const Edit& edit)
+        {
+            // The remaining edits are still enumerated, but once there are
+            // enough suggestions, nothing more is looked up.
+            if (suggest.size() >= maxCount)
+            {
+                return;
+            }
+
+            unsigned int length = editedLength(word, edit);
+
+            if (hashedWords->anyInBucket(
+                    hash, [=](const std::string& key) { return key.length() == length; })
+                && (prefilter == nullptr
+                    || prefilter->mayContain(
+                        length,
+                        [&](unsigned int i) { return editedCharAt(word, edit, i); })))
+            {
+                std::string candidate = applyEdit(word, edit);
+
+                if (hashedWords->containsHashed(hash, candidate))
+                {
+                    addSuggestion(suggest, std::move(candidate));
+                }
+            }
+        });
+
     return suggest;
 }
 
+
+std::vector<std::string> WordChecker::generateCandidates(const std::string& word) const
+{
+    std::vector<std::string> candidates;
+    candidates.reserve(word.size() * (2 * (asciiLetters.size() + otherLetters.size()) + 3));
+
+    forEachEdit(
+        word, NoHasher{}, asciiLetters, otherLetters,
+        [&](unsigned int, const Edit& edit) { candidates.push_back(applyEdit(word, edit)); });
+
+    return candidates;
+}
@@ -14,15 +14,21 @@
 #ifndef WORDCHECKER_HPP
 #define WORDCHECKER_HPP
 
+#include <cstddef>
 #include <string>
 #include <cstring>
 #include <vector>
 #include "Set.hpp"
+#include "WordPrefilter.hpp"
 #include <algorithm>
 #include <iostream>
 #include <iterator>
 
 
+template <typename T>
+class HashSet;
+
+
 
 class WordChecker
 {
@@ -33,6 +39,13 @@ public:
     WordChecker(const Set<std::string>& words);
 
 
+    // This constructor also takes a WordPrefilter summarizing the same
+    // words, which is consulted before any lookup in the set, so that most
+    // words that aren't in the set are ruled out without searching for
+    // them.  The WordChecker stores a reference to the prefilter, too.
+    WordChecker(const Set<std::string>& words, const WordPrefilter& prefilter);
+
+
     // wordExists() returns true if the given word is spelled correctly,
     // false otherwise.
     bool wordExists(const std::string& word) const;
@@ -40,12 +53,62 @@ public:
 
     // findSuggestions() returns a vector containing suggested alternative
     // spellings for the given word, using the five algorithms described in
-    // the project write-up.
+    // the project write-up.  Words that aren't ASCII are treated as UTF-8,
+    // so their characters are swapped, deleted, and replaced whole.
     std::vector<std::string> findSuggestions(const std::string& word) const;
 
 
+    // This version of findSuggestions() returns at most the given number
+    // of suggestions: the first ones that findSuggestions() would have
+    // returned.  When it can, it stops looking up candidates once it has
+    // found enough, so asking for fewer suggestions is cheaper.
+    std::vector<std::string> findSuggestions(
+        const std::string& word, std::size_t maxCount) const;
+
+
+    // addLetters() adds letters (each a UTF-8 encoded character) to the
+    // ones inserted and substituted when generating candidate spellings,
+    // which are otherwise the letters 'A' through 'Z'.  Letters are tried
+    // after 'A' through 'Z' (ASCII ones first, then the others, each in
+    // the order they were added), so adding letters doesn't change the
+    // order of the suggestions that use only those.  Typically, the
+    // letters are a dictionary's alphabet (see WordSetLoader::alphabet()).
+    void addLetters(const std::vector<std::string>& moreLetters);
+
+
 private:
+    WordChecker(const Set<std::string>& words, const WordPrefilter* prefilter);
+
+    // The letters that are inserted and substituted when generating
+    // candidate spellings: the ones in letter, followed by any that were
+    // added by addLetters(), kept apart from the letters outside of ASCII
+    // so that the ASCII letters can be handled a byte at a time.
+    static const std::string letter;
+    std::string asciiLetters;
+    std::vector<std::string> otherLetters;
+
     const Set<std::string>& words;
+
+    // If words is a HashSet using hashStringAsProduct(), this points to it,
+    // so suggestions can be found with incremental hashing; otherwise,
+    // it's nullptr.
+    const HashSet<std::string>* hashedWords;
+
+    // The prefilter given to the constructor, or nullptr if there isn't one.
+    const WordPrefilter* prefilter;
+
+    // generateCandidates() returns every candidate spelling that
+    // findSuggestions() considers for the given word, in the order in
+    // which they'd be suggested, whether or not they're in the set.
+    std::vector<std::string> generateCandidates(const std::string& word) const;
+
+    // findSuggestionsByHash() returns the same suggestions as
+    // findSuggestions() (up to the given number of them), but computes the
+    // hash of each candidate from the hashes of the word's prefixes,
+    // building only the candidates whose bucket holds a word of the same
+    // length.
+    std::vector<std::string> findSuggestionsByHash(
+        const std::string& word, std::size_t maxCount) const;
 };
 
 
@@ -0,0 +1,48 @@
+// WordPrefilter.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "WordPrefilter.hpp"
+
+
+
+void WordPrefilter::add(const std::string& word)
+{
+    if (partitions.size() <= word.length())
+    {
+        partitions.resize(word.length() + 1, LengthPartition{0, {}, {}});
+    }
+
+    LengthPartition& partition = partitions[word.length()];
+
+    if (partition.positionMasks.empty())
+    {
+        partition.positionMasks.resize(word.length(), 0);
+    }
+
+    std::uint32_t signature = 0;
+
+    for (unsigned int i = 0; i < word.length(); ++i)
+    {
+        std::uint32_t bit = characterBit(word[i]);
+        partition.positionMasks[i] |= bit;
+        signature |= bit;
+    }
+
+    partition.signatures.insert(signature);
+    ++partition.count;
+    ++count;
+}
+
+
+bool WordPrefilter::mayContain(const std::string& word) const
+{
+    return mayContain(word.length(), [&](unsigned int i) { return word[i]; });
+}
+
+
+unsigned int WordPrefilter::size() const
+{
+    return count;
+}
@@ -0,0 +1,157 @@
+// WordPrefilter.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A WordPrefilter summarizes a word set cheaply enough that most strings
+// that are not in the set can be ruled out with a few bit tests, before
+// the (comparatively expensive) lookup in the set itself.  The words are
+// partitioned by length; for each length, the prefilter keeps:
+//
+// * a bitmask for each position, recording which characters appear at
+//   that position in at least one word of that length
+// * the distinct "signatures" of the words of that length, where a
+//   signature is a bitmask recording which characters appear anywhere
+//   in a word
+//
+// mayContain() never returns false for a word that was added, but can
+// return true for words that weren't.
+
+#ifndef WORDPREFILTER_HPP
+#define WORDPREFILTER_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Normalization.hpp"
+
+
+
+class WordPrefilter
+{
+public:
+    // add() records a word, so that mayContain() will return true for it.
+    void add(const std::string& word);
+
+
+    // mayContain() returns false if the word was definitely never added,
+    // or true if it might have been.
+    bool mayContain(const std::string& word) const;
+
+
+    // This version of mayContain() asks about a word of the given length
+    // whose characters are given by charAt(0) through charAt(length - 1),
+    // so that the word doesn't have to be built in order to be ruled out.
+    template <typename CharAt>
+    bool mayContain(unsigned int length, CharAt charAt) const;
+
+
+    // size() returns the number of words that have been added, counting
+    // duplicates.
+    unsigned int size() const;
+
+
+private:
+    static std::uint32_t characterBit(char c);
+
+    struct LengthPartition
+    {
+        unsigned int count;
+        std::vector<std::uint32_t> positionMasks;
+        std::unordered_set<std::uint32_t> signatures;
+    };
+
+    // partitions[n] summarizes the words of length n.
+    std::vector<LengthPartition> partitions;
+
+    unsigned int count = 0;
+};
+
+
+
+// Each character is mapped to one bit of a 32-bit mask.  The letters
+// get a bit of their own, regardless of case; other characters share
+// bits, which makes the prefilter a little less selective but never
+// wrong.  The mapping is looked up in a table built at compile time.
+namespace word_prefilter_detail
+{
+    constexpr std::array<std::uint32_t, 256> makeCharacterBits()
+    {
+        std::array<std::uint32_t, 256> bits{};
+
+        for (unsigned int i = 0; i < 256; ++i)
+        {
+            char c = toUppercase(static_cast<char>(i));
+
+            if (c >= 'A' && c <= 'Z')
+            {
+                bits[i] = std::uint32_t{1} << (c - 'A');
+            }
+            else if (c == '\'')
+            {
+                bits[i] = std::uint32_t{1} << 26;
+            }
+            else if (c == '-')
+            {
+                bits[i] = std::uint32_t{1} << 27;
+            }
+            else if (isWordStart(c))
+            {
+                bits[i] = std::uint32_t{1} << 28;
+            }
+            else if (c == ' ')
+            {
+                bits[i] = std::uint32_t{1} << 29;
+            }
+            else
+            {
+                bits[i] = std::uint32_t{1} << 31;
+            }
+        }
+
+        return bits;
+    }
+
+
+    constexpr std::array<std::uint32_t, 256> CHARACTER_BITS = makeCharacterBits();
+}
+
+
+inline std::uint32_t WordPrefilter::characterBit(char c)
+{
+    return word_prefilter_detail::CHARACTER_BITS[static_cast<unsigned char>(c)];
+}
+
+
+template <typename CharAt>
+bool WordPrefilter::mayContain(unsigned int length, CharAt charAt) const
+{
+    if (length >= partitions.size() || partitions[length].count == 0)
+    {
+        return false;
+    }
+
+    const LengthPartition& partition = partitions[length];
+
+    std::uint32_t signature = 0;
+
+    for (unsigned int i = 0; i < length; ++i)
+    {
+        std::uint32_t bit = characterBit(charAt(i));
+
+        if ((partition.positionMasks[i] & bit) == 0)
+        {
+            return false;
+        }
+
+        signature |= bit;
+    }
+
+    return partition.signatures.count(signature) != 0;
+}
+
+
+
+#endif // WORDPREFILTER_HPP
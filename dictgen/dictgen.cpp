@@ -0,0 +1,266 @@
+// dictgen.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Generates the C++ source file holding the dictionary embedded in an
+// EmbeddedSet (see EmbeddedSet.hpp).  It's run by the build, as
+//
+//     a.out.dictgen WORD_FILE OUTPUT_FILE
+//
+// and reads the words from the word file the same way a WordSetLoader
+// reading UTF-8 does, one per line, made uppercase (including the letters
+// outside of ASCII) and with carriage returns removed.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "EmbeddedSet.hpp"
+#include "Normalization.hpp"
+
+
+
+namespace
+{
+    // The number of different displacements tried for a bucket before
+    // giving up; with the table's load factor, this is never approached.
+    constexpr std::uint32_t MAXIMUM_DISPLACEMENT = 100000000;
+
+
+    struct Table
+    {
+        std::vector<std::uint32_t> displacements;
+        std::vector<std::uint32_t> slots;
+    };
+
+
+    std::vector<std::string> readWords(const std::string& wordFilePath)
+    {
+        std::ifstream wordFile{wordFilePath, std::ios::binary};
+
+        std::vector<std::string> words;
+        std::unordered_set<std::string> seen;
+        std::string line;
+
+        while (std::getline(wordFile, line))
+        {
+            std::string word = normalizeWord(line, TextEncoding::Utf8);
+
+            if (seen.insert(word).second)
+            {
+                words.push_back(word);
+            }
+        }
+
+        return words;
+    }
+
+
+    bool buildTable(const std::vector<std::string>& words, Table& table)
+    {
+        std::uint32_t bucketCount = words.size() / 4 + 1;
+        std::uint32_t slotCount = words.size() + words.size() / 8 + 1;
+
+        std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+
+        for (std::uint32_t i = 0; i < words.size(); ++i)
+        {
+            buckets[EmbeddedSet::hash(words[i], 0) % bucketCount].push_back(i);
+        }
+
+        // The buckets with the most words are placed first, while most of
+        // the slots are still free.
+        std::vector<std::uint32_t> bucketOrder(bucketCount);
+
+        for (std::uint32_t b = 0; b < bucketCount; ++b)
+        {
+            bucketOrder[b] = b;
+        }
+
+        std::stable_sort(
+            bucketOrder.begin(), bucketOrder.end(),
+            [&](std::uint32_t a, std::uint32_t b)
+            {
+                return buckets[a].size() > buckets[b].size();
+            });
+
+        table.displacements.assign(bucketCount, 0);
+        table.slots.assign(slotCount, EmbeddedSet::EMPTY_SLOT);
+
+        std::vector<std::uint32_t> chosen;
+
+        for (std::uint32_t b : bucketOrder)
+        {
+            if (buckets[b].empty())
+            {
+                break;
+            }
+
+            std::uint32_t displacement = 1;
+
+            for (; displacement < MAXIMUM_DISPLACEMENT; ++displacement)
+            {
+                chosen.clear();
+
+                for (std::uint32_t word : buckets[b])
+                {
+                    std::uint32_t slot =
+                        EmbeddedSet::hash(words[word], displacement) % slotCount;
+
+                    if (table.slots[slot] != EmbeddedSet::EMPTY_SLOT
+                        || std::find(chosen.begin(), chosen.end(), slot) != chosen.end())
+                    {
+                        break;
+                    }
+
+                    chosen.push_back(slot);
+                }
+
+                if (chosen.size() == buckets[b].size())
+                {
+                    break;
+                }
+            }
+
+            if (displacement == MAXIMUM_DISPLACEMENT)
+            {
+                return false;
+            }
+
+            table.displacements[b] = displacement;
+
+            for (std::size_t i = 0; i < chosen.size(); ++i)
+            {
+                table.slots[chosen[i]] = buckets[b][i];
+            }
+        }
+
+        return true;
+    }
+
+
+    void writeNumbers(
+        std::ostream& out, const std::string& name, const std::vector<std::uint32_t>& numbers)
+    {
+        out << "    constexpr std::uint32_t " << name << "[] =\n";
+        out << "    {";
+
+        for (std::size_t i = 0; i < numbers.size(); ++i)
+        {
+            out << (i % 12 == 0 ? "\n        " : " ") << numbers[i] << "u,";
+        }
+
+        out << "\n    };\n";
+    }
+
+
+    void writeKeys(std::ostream& out, const std::vector<std::string>& words)
+    {
+        static const char digits[] = "01234567";
+
+        out << "    constexpr char KEYS[] =\n";
+        out << "        \"";
+
+        std::size_t column = 0;
+
+        for (const std::string& word : words)
+        {
+            for (char c : word)
+            {
+                unsigned char u = c;
+
+                if (u >= ' ' && u <= '~' && c != '"' && c != '\\' && c != '?')
+                {
+                    out << c;
+                }
+                else
+                {
+                    out << '\\' << digits[u >> 6] << digits[(u >> 3) & 7] << digits[u & 7];
+                }
+
+                if (++column == 72)
+                {
+                    out << "\"\n        \"";
+                    column = 0;
+                }
+            }
+        }
+
+        out << "\";\n";
+    }
+
+
+    void writeSource(
+        std::ostream& out, const std::string& wordFilePath,
+        const std::vector<std::string>& words, const Table& table)
+    {
+        std::vector<std::uint32_t> wordOffsets{0};
+
+        for (const std::string& word : words)
+        {
+            wordOffsets.push_back(wordOffsets.back() + word.length());
+        }
+
+        out << "// EmbeddedDictionary.cpp\n";
+        out << "//\n";
+        out << "// Generated by a.out.dictgen from " << wordFilePath << "; do not edit.\n";
+        out << "\n";
+        out << "#include \"EmbeddedSet.hpp\"\n";
+        out << "\n\n\n";
+        out << "namespace\n";
+        out << "{\n";
+        writeKeys(out, words);
+        out << "\n\n";
+        writeNumbers(out, "WORD_OFFSETS", wordOffsets);
+        out << "\n\n";
+        writeNumbers(out, "DISPLACEMENTS", table.displacements);
+        out << "\n\n";
+        writeNumbers(out, "SLOTS", table.slots);
+        out << "}\n";
+        out << "\n\n\n";
+        out << "const EmbeddedSet::Dictionary EmbeddedSet::dictionary\n";
+        out << "{\n";
+        out << "    KEYS, WORD_OFFSETS, " << words.size() << "u,\n";
+        out << "    DISPLACEMENTS, " << table.displacements.size() << "u,\n";
+        out << "    SLOTS, " << table.slots.size() << "u\n";
+        out << "};\n";
+    }
+}
+
+
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " WORD_FILE OUTPUT_FILE" << std::endl;
+        return 1;
+    }
+
+    std::string wordFilePath = argv[1];
+    std::string outputFilePath = argv[2];
+
+    std::vector<std::string> words = readWords(wordFilePath);
+
+    Table table;
+
+    if (!buildTable(words, table))
+    {
+        std::cerr << "Could not build a perfect hash table for " << wordFilePath << std::endl;
+        return 1;
+    }
+
+    std::ofstream output{outputFilePath};
+    writeSource(output, wordFilePath, words, table);
+
+    if (!output)
+    {
+        std::cerr << "Could not write " << outputFilePath << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+// AsyncFileReaderTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the AsyncFileReader and AsyncLineSource, using chunks
+// small enough that many reads are in flight and lines are cut off by the
+// ends of chunks.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AsyncFileReader.hpp"
+#include "AsyncLineSource.hpp"
+
+
+namespace
+{
+    std::string temporaryPath()
+    {
+        return testing::TempDir() + "AsyncFileReaderTests.txt";
+    }
+
+
+    std::string writeTemporaryFile(const std::string& contents)
+    {
+        std::ofstream file{temporaryPath(), std::ios::binary};
+        file << contents;
+        return temporaryPath();
+    }
+
+
+    std::string someLines()
+    {
+        std::string text;
+
+        for (unsigned int i = 0; i < 5000; ++i)
+        {
+            text += std::string(i % 37, 'a' + i % 26) + "\n";
+        }
+
+        return text + "no newline at the end";
+    }
+}
+
+
+TEST(AsyncFileReaderTests, chunksMakeUpTheWholeFile)
+{
+    std::string text = someLines();
+    AsyncFileReader reader{writeTemporaryFile(text), 1000, 3};
+
+    std::string read;
+    std::string_view chunk;
+
+    while (reader.nextChunk(chunk))
+    {
+        EXPECT_LE(chunk.length(), 1000);
+        read.append(chunk.data(), chunk.length());
+    }
+
+    EXPECT_EQ(text, read);
+    EXPECT_FALSE(reader.nextChunk(chunk));
+
+    std::remove(temporaryPath().c_str());
+}
+
+
+TEST(AsyncFileReaderTests, missingFilesAreEmpty)
+{
+    AsyncFileReader reader{testing::TempDir() + "no-such-file.txt"};
+    std::string_view chunk;
+
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_FALSE(reader.nextChunk(chunk));
+}
+
+
+TEST(AsyncFileReaderTests, lineSourceCarriesLinesAcrossChunks)
+{
+    std::string text = someLines();
+    AsyncLineSource source{writeTemporaryFile(text), 7};
+
+    std::string read;
+    std::string_view line;
+
+    while (source.nextLine(line))
+    {
+        read.append(line.data(), line.length());
+        read.push_back('\n');
+    }
+
+    EXPECT_EQ(text + "\n", read);
+
+    std::remove(temporaryPath().c_str());
+}
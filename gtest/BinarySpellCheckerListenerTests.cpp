@@ -0,0 +1,93 @@
+// BinarySpellCheckerListenerTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the BinarySpellCheckerListener, which decode the records
+// it writes and compare them to the misspellings it was given.
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BinarySpellCheckerListener.hpp"
+
+
+namespace
+{
+    class RecordReader
+    {
+    public:
+        RecordReader(const std::string& bytes)
+            : bytes{bytes}, position{0}
+        {
+        }
+
+        std::uint64_t integer(unsigned int byteCount)
+        {
+            std::uint64_t value = 0;
+
+            for (unsigned int i = 0; i < byteCount; ++i)
+            {
+                std::uint64_t byte = static_cast<unsigned char>(bytes.at(position++));
+                value |= byte << (8 * i);
+            }
+
+            return value;
+        }
+
+        std::string string()
+        {
+            std::size_t length = integer(2);
+            std::string text = bytes.substr(position, length);
+            position += length;
+            return text;
+        }
+
+        std::size_t remaining() const
+        {
+            return bytes.length() - position;
+        }
+
+    private:
+        std::string bytes;
+        std::size_t position;
+    };
+}
+
+
+TEST(BinarySpellCheckerListenerTests, writesLengthPrefixedRecords)
+{
+    std::ostringstream out;
+
+    {
+        BinarySpellCheckerListener listener{out};
+        std::string line = "the cta sat on teh mat";
+
+        listener.misspellingFound(Misspelling{"CTA", line, 12, 300, 4, 3}, {"CAT", "ACT"});
+        listener.misspellingFound(Misspelling{"TEH", line, 13, 330, 15, 3}, {});
+    }
+
+    ASSERT_EQ("WCB1", out.str().substr(0, 4));
+
+    RecordReader reader{out.str().substr(4)};
+
+    EXPECT_EQ(8 + 8 + 4 + 5 + 2 + 5 + 5, reader.integer(4));
+    EXPECT_EQ(12, reader.integer(8));
+    EXPECT_EQ(300, reader.integer(8));
+    EXPECT_EQ(4, reader.integer(4));
+    EXPECT_EQ("CTA", reader.string());
+    ASSERT_EQ(2, reader.integer(2));
+    EXPECT_EQ("CAT", reader.string());
+    EXPECT_EQ("ACT", reader.string());
+
+    EXPECT_EQ(8 + 8 + 4 + 5 + 2, reader.integer(4));
+    EXPECT_EQ(13, reader.integer(8));
+    EXPECT_EQ(330, reader.integer(8));
+    EXPECT_EQ(15, reader.integer(4));
+    EXPECT_EQ("TEH", reader.string());
+    EXPECT_EQ(0, reader.integer(2));
+
+    EXPECT_EQ(0, reader.remaining());
+}
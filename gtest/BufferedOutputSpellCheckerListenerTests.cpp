@@ -0,0 +1,74 @@
+// BufferedOutputSpellCheckerListenerTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the BufferedOutputSpellCheckerListener, which check that
+// its output matches an OutputSpellCheckerListener's, and that it holds
+// onto its output until it's time to write it.
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BufferedOutputSpellCheckerListener.hpp"
+#include "OutputSpellCheckerListener.hpp"
+
+
+namespace
+{
+    void reportTwoMisspellings(SpellCheckerListener& listener)
+    {
+        std::string line = "the cta sat on teh mat";
+
+        listener.misspellingFound(Misspelling{"CTA", line, 1, 0, 4, 3}, {"CAT", "ACT"});
+        listener.misspellingFound(Misspelling{"TEH", line, 1, 0, 15, 3}, {});
+    }
+}
+
+
+TEST(BufferedOutputSpellCheckerListenerTests, writesTheSameOutputWhenFinished)
+{
+    std::ostringstream expected;
+    OutputSpellCheckerListener unbuffered{expected};
+    reportTwoMisspellings(unbuffered);
+
+    std::ostringstream actual;
+    BufferedOutputSpellCheckerListener buffered{actual};
+    reportTwoMisspellings(buffered);
+
+    EXPECT_EQ("", actual.str());
+
+    buffered.checkingFinished();
+    EXPECT_EQ(expected.str(), actual.str());
+}
+
+
+TEST(BufferedOutputSpellCheckerListenerTests, writesWhenTheBufferFills)
+{
+    std::ostringstream actual;
+    BufferedOutputSpellCheckerListener buffered{actual};
+
+    std::string line(1000, 'x');
+
+    while (actual.str().empty())
+    {
+        buffered.misspellingFound(Misspelling{"X", line, 1, 0, 0, 1}, {});
+    }
+
+    EXPECT_GE(actual.str().length(), BufferedOutputSpellCheckerListener::FLUSH_SIZE);
+    EXPECT_LT(actual.str().length(), BufferedOutputSpellCheckerListener::FLUSH_SIZE + 2000);
+}
+
+
+TEST(BufferedOutputSpellCheckerListenerTests, writesWhatsLeftWhenDestroyed)
+{
+    std::ostringstream actual;
+
+    {
+        BufferedOutputSpellCheckerListener buffered{actual};
+        reportTwoMisspellings(buffered);
+    }
+
+    EXPECT_NE("", actual.str());
+}
@@ -0,0 +1,192 @@
+// CompiledSetTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the CompiledSet, including saving compiled dictionaries
+// and opening them again.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompiledSet.hpp"
+
+
+namespace
+{
+    std::string temporaryPath()
+    {
+        return testing::TempDir() + "CompiledSetTests.dict";
+    }
+}
+
+
+TEST(CompiledSetTests, containsOnlyAddedWords)
+{
+    std::vector<std::string> words{"CAT", "DOG", "", "CAT", "DON'T"};
+
+    CompiledSet s;
+    s.addAll(words.data(), words.size());
+    s.add("BIRD");
+
+    EXPECT_EQ(5, s.size());
+
+    for (const char* word : {"CAT", "DOG", "", "DON'T", "BIRD"})
+    {
+        EXPECT_TRUE(s.contains(word)) << word;
+    }
+
+    EXPECT_FALSE(s.contains("CATS"));
+    EXPECT_FALSE(s.contains("CA"));
+}
+
+
+TEST(CompiledSetTests, wordsAreIndexedInTheOrderAdded)
+{
+    std::vector<std::string> words{"ZEBRA", "APPLE", "MANGO", "APPLE", "KIWI"};
+
+    CompiledSet s;
+    s.addAll(words.data(), words.size());
+
+    std::vector<std::string> indexed;
+
+    for (unsigned int i = 0; i < s.size(); ++i)
+    {
+        indexed.emplace_back(s.word(i));
+    }
+
+    EXPECT_EQ((std::vector<std::string>{"ZEBRA", "APPLE", "MANGO", "KIWI"}), indexed);
+}
+
+
+TEST(CompiledSetTests, wordsAddedBetweenLookupsAreFound)
+{
+    CompiledSet s;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add("W" + std::to_string(i));
+    }
+
+    EXPECT_EQ(1000, s.size());
+    EXPECT_TRUE(s.contains("W0"));
+    EXPECT_TRUE(s.contains("W999"));
+
+    s.add("W0");
+    s.add("EXTRA");
+
+    EXPECT_TRUE(s.contains("EXTRA"));
+    EXPECT_EQ(1001, s.size());
+    EXPECT_EQ("W0", s.word(0));
+    EXPECT_EQ("EXTRA", s.word(1000));
+}
+
+
+TEST(CompiledSetTests, canSaveAndOpenAgain)
+{
+    std::vector<std::string> words;
+
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+        words.push_back("WORD" + std::to_string(i));
+    }
+
+    CompiledSet original;
+    original.addAll(words.data(), words.size());
+    ASSERT_TRUE(original.save(temporaryPath()));
+    EXPECT_TRUE(CompiledSet::isCompiled(temporaryPath()));
+
+    CompiledSet opened;
+    opened.open(temporaryPath());
+
+    EXPECT_EQ(words.size(), opened.size());
+
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(opened.contains(word)) << word;
+    }
+
+    EXPECT_FALSE(opened.contains("WORD10000"));
+
+    // Adding to an opened set copies it out of the file.
+    opened.add("ANOTHER");
+    EXPECT_TRUE(opened.contains("ANOTHER"));
+    EXPECT_TRUE(opened.contains("WORD0"));
+
+    std::remove(temporaryPath().c_str());
+}
+
+
+TEST(CompiledSetTests, rejectsDamagedFiles)
+{
+    std::vector<std::string> words{"ALPHA", "BETA", "GAMMA"};
+
+    CompiledSet original;
+    original.addAll(words.data(), words.size());
+    ASSERT_TRUE(original.save(temporaryPath()));
+
+    {
+        // Three words are given four buckets, whose five indexes follow the
+        // 32-byte header.
+        std::fstream file{temporaryPath(), std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(32);
+        file << std::string(5 * 4, '\xff');
+    }
+
+    // Opening checks only the header, so the damage is found by the lookup.
+    CompiledSet damaged;
+    ASSERT_NO_THROW(damaged.open(temporaryPath()));
+    EXPECT_THROW(damaged.contains("BETA"), CompiledSet::FormatException);
+
+    CompiledSet verified;
+    EXPECT_THROW(verified.open(temporaryPath(), true), CompiledSet::FormatException);
+    EXPECT_EQ(0, verified.size());
+
+    {
+        std::ofstream file{temporaryPath(), std::ios::binary | std::ios::app};
+        file << "EXTRA";
+    }
+
+    CompiledSet tooLong;
+    EXPECT_THROW(tooLong.open(temporaryPath()), CompiledSet::FormatException);
+    EXPECT_EQ(0, tooLong.size());
+
+    {
+        std::ofstream file{temporaryPath(), std::ios::binary | std::ios::trunc};
+        file << "ALPHA\nBETA\n";
+    }
+
+    EXPECT_FALSE(CompiledSet::isCompiled(temporaryPath()));
+    EXPECT_THROW(tooLong.open(temporaryPath()), CompiledSet::FormatException);
+
+    std::remove(temporaryPath().c_str());
+}
+
+
+TEST(CompiledSetTests, verifiesTheChecksumOnlyWhenAsked)
+{
+    std::vector<std::string> words{"ALPHA", "BETA", "GAMMA"};
+
+    CompiledSet original;
+    original.addAll(words.data(), words.size());
+    ASSERT_TRUE(original.save(temporaryPath()));
+
+    {
+        // Damaging a word's characters leaves the image's structure intact.
+        std::fstream file{temporaryPath(), std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(-2, std::ios::end);
+        file.put('?');
+    }
+
+    CompiledSet unverified;
+    EXPECT_NO_THROW(unverified.open(temporaryPath()));
+    EXPECT_EQ(3, unverified.size());
+
+    CompiledSet verified;
+    EXPECT_THROW(verified.open(temporaryPath(), true), CompiledSet::FormatException);
+    EXPECT_EQ(0, verified.size());
+
+    std::remove(temporaryPath().c_str());
+}
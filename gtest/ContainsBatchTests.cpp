@@ -0,0 +1,88 @@
+// ContainsBatchTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests ensuring that each set's containsBatch() gives the same
+// answers as asking contains() about each element one at a time.
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "BSTSet.hpp"
+#include "HashSet.hpp"
+#include "ListSet.hpp"
+#include "StringHashing.hpp"
+
+
+namespace
+{
+    std::string makeWord(unsigned int i)
+    {
+        std::string digits = std::to_string(i);
+        return "W" + std::string(4 - digits.length(), '0') + digits;
+    }
+
+
+    void expectBatchMatchesContains(Set<std::string>& s)
+    {
+        // Every tenth word is added, in sorted order, the way the words
+        // in a word set file appear.
+        for (unsigned int i = 0; i < 1000; i += 10)
+        {
+            s.add(makeWord(i));
+        }
+
+        std::vector<std::string> queries;
+
+        for (unsigned int i = 0; i < 1000; ++i)
+        {
+            queries.push_back(makeWord((i * 7919) % 1000));
+        }
+
+        std::unique_ptr<bool[]> found{new bool[queries.size()]};
+        s.containsBatch(queries.data(), queries.size(), found.get());
+
+        for (unsigned int i = 0; i < queries.size(); ++i)
+        {
+            EXPECT_EQ(s.contains(queries[i]), found[i]) << queries[i];
+        }
+    }
+}
+
+
+TEST(ContainsBatchTests, hashSetMatchesContains)
+{
+    HashSet<std::string> s{hashStringAsProduct};
+    expectBatchMatchesContains(s);
+}
+
+
+TEST(ContainsBatchTests, bstSetMatchesContains)
+{
+    BSTSet<std::string> s;
+    expectBatchMatchesContains(s);
+}
+
+
+TEST(ContainsBatchTests, avlSetMatchesContains)
+{
+    AVLSet<std::string> s;
+    expectBatchMatchesContains(s);
+}
+
+
+TEST(ContainsBatchTests, defaultMatchesContains)
+{
+    ListSet<std::string> s;
+    expectBatchMatchesContains(s);
+}
+
+
+TEST(ContainsBatchTests, emptyBatchIsAllowed)
+{
+    HashSet<std::string> s{hashStringAsProduct};
+    s.containsBatch(nullptr, 0, nullptr);
+}
@@ -0,0 +1,51 @@
+// EmbeddedSetTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the EmbeddedSet, whose words are generated from
+// wordset.txt when the program is built.
+
+#include <string>
+#include <gtest/gtest.h>
+#include "EmbeddedSet.hpp"
+
+
+TEST(EmbeddedSetTests, containsEveryEmbeddedWord)
+{
+    EmbeddedSet s;
+
+    ASSERT_LT(0, EmbeddedSet::embeddedSize());
+    EXPECT_EQ(EmbeddedSet::embeddedSize(), s.size());
+
+    for (unsigned int i = 0; i < EmbeddedSet::embeddedSize(); ++i)
+    {
+        ASSERT_TRUE(s.contains(std::string{EmbeddedSet::embeddedWord(i)}))
+            << EmbeddedSet::embeddedWord(i);
+    }
+}
+
+
+TEST(EmbeddedSetTests, doesNotContainOtherWords)
+{
+    EmbeddedSet s;
+
+    EXPECT_FALSE(s.contains("QWXZQ"));
+    EXPECT_FALSE(s.contains("abandon"));
+    EXPECT_FALSE(s.contains(""));
+}
+
+
+TEST(EmbeddedSetTests, canAddWordsThatAreNotEmbedded)
+{
+    EmbeddedSet s;
+    std::string embedded{EmbeddedSet::embeddedWord(0)};
+
+    s.add(embedded);
+    EXPECT_EQ(EmbeddedSet::embeddedSize(), s.size());
+
+    s.add("QWXZQ");
+    s.add("QWXZQ");
+    EXPECT_TRUE(s.contains("QWXZQ"));
+    EXPECT_EQ(EmbeddedSet::embeddedSize() + 1, s.size());
+}
@@ -0,0 +1,52 @@
+// JsonLinesSpellCheckerListenerTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the JsonLinesSpellCheckerListener, which check the
+// records it writes, including how it escapes text.
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "JsonLinesSpellCheckerListener.hpp"
+
+
+TEST(JsonLinesSpellCheckerListenerTests, writesOneRecordPerLine)
+{
+    std::ostringstream out;
+
+    {
+        JsonLinesSpellCheckerListener listener{out};
+        std::string line = "the cta sat on teh mat";
+
+        listener.misspellingFound(Misspelling{"CTA", line, 12, 300, 4, 3}, {"CAT", "ACT"});
+        listener.misspellingFound(Misspelling{"TEH", line, 12, 300, 15, 3}, {});
+        listener.checkingFinished();
+    }
+
+    EXPECT_EQ(
+        "{\"word\":\"CTA\",\"line\":12,\"column\":4,\"offset\":304,"
+        "\"suggestions\":[\"CAT\",\"ACT\"]}\n"
+        "{\"word\":\"TEH\",\"line\":12,\"column\":15,\"offset\":315,\"suggestions\":[]}\n",
+        out.str());
+}
+
+
+TEST(JsonLinesSpellCheckerListenerTests, escapesQuotesBackslashesAndControlCharacters)
+{
+    std::ostringstream out;
+
+    {
+        JsonLinesSpellCheckerListener listener{out};
+        std::string line = "a\"b\\c\td";
+
+        listener.misspellingFound(Misspelling{line, line, 1, 0, 0, line.length()}, {});
+    }
+
+    EXPECT_EQ(
+        "{\"word\":\"a\\\"b\\\\c\\u0009d\",\"line\":1,\"column\":0,\"offset\":0,"
+        "\"suggestions\":[]}\n",
+        out.str());
+}
@@ -0,0 +1,69 @@
+// MisspellingBatchTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the MisspellingBatch, which check that the misspellings
+// it returns describe the text it was given, even after the original
+// text is gone.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "MisspellingBatch.hpp"
+
+
+TEST(MisspellingBatchTests, keepsCopiesOfTheText)
+{
+    MisspellingBatch batch;
+
+    {
+        std::string line = "the cta sat on teh mat";
+        std::string first = "CTA";
+        std::string second = "TEH";
+
+        batch.add(Misspelling{first, line, 7, 120, 4, 3}, {"CAT", "ACT"});
+        batch.add(Misspelling{second, line, 7, 120, 15, 3}, {"THE"});
+
+        std::string nextLine = "dgo";
+        std::string third = "DGO";
+        batch.add(Misspelling{third, nextLine, 8, 143, 0, 3}, {});
+    }
+
+    ASSERT_EQ(3, batch.size());
+
+    Misspelling first = batch.misspelling(0);
+    EXPECT_EQ("CTA", first.word);
+    EXPECT_EQ("the cta sat on teh mat", first.line);
+    EXPECT_EQ("cta", first.text());
+    EXPECT_EQ(7, first.lineNumber);
+    EXPECT_EQ(120, first.lineOffset);
+    EXPECT_EQ((std::vector<std::string>{"CAT", "ACT"}), batch.suggestions(0));
+
+    Misspelling second = batch.misspelling(1);
+    EXPECT_EQ("teh", second.text());
+    EXPECT_EQ(first.line.data(), second.line.data());
+
+    Misspelling third = batch.misspelling(2);
+    EXPECT_EQ("dgo", third.line);
+    EXPECT_EQ(8, third.lineNumber);
+    EXPECT_TRUE(batch.suggestions(2).empty());
+}
+
+
+TEST(MisspellingBatchTests, canBeClearedAndRefilled)
+{
+    MisspellingBatch batch;
+    std::string line = "abc";
+
+    batch.add(Misspelling{"ABC", line, 1, 0, 0, 3}, {});
+    batch.clear();
+
+    EXPECT_TRUE(batch.empty());
+
+    batch.add(Misspelling{"ABC", line, 2, 4, 0, 3}, {"ABS"});
+
+    ASSERT_EQ(1, batch.size());
+    EXPECT_EQ(2, batch.misspelling(0).lineNumber);
+    EXPECT_EQ("abc", batch.misspelling(0).line);
+}
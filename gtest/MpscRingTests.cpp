@@ -0,0 +1,81 @@
+// MpscRingTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the MpscRing, which check that values pushed by several
+// threads at once are each popped exactly once, in the order each thread
+// pushed them.
+
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "MpscRing.hpp"
+
+
+TEST(MpscRingTests, pushingFailsWhenFull)
+{
+    MpscRing<int> ring{2};
+
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    ASSERT_TRUE(ring.tryPush(a));
+    ASSERT_TRUE(ring.tryPush(b));
+    EXPECT_FALSE(ring.tryPush(c));
+
+    int value;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(1, value);
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+
+TEST(MpscRingTests, everyProducersValuesArriveInOrder)
+{
+    MpscRing<std::pair<int, int>> ring{8};
+    const int producerCount = 4;
+    const int count = 20000;
+
+    std::vector<std::thread> producers;
+
+    for (int producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back(
+            [&, producer]()
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    std::pair<int, int> value{producer, i};
+
+                    while (!ring.tryPush(value))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    std::vector<int> next(producerCount, 0);
+
+    for (int received = 0; received < producerCount * count; ++received)
+    {
+        std::pair<int, int> value;
+
+        while (!ring.tryPop(value))
+        {
+            std::this_thread::yield();
+        }
+
+        ASSERT_EQ(next[value.first], value.second);
+        ++next[value.first];
+    }
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+}
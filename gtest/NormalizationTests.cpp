@@ -0,0 +1,195 @@
+// NormalizationTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the character classification and normalization rules,
+// which check the generated tables against the C library in the "C"
+// locale, and the UTF-8 decoder against valid and invalid sequences.
+
+#include <cctype>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Normalization.hpp"
+#include "Tokenizer.hpp"
+
+
+namespace
+{
+    std::vector<std::string> utf8Words(const std::string& line)
+    {
+        std::vector<Token> tokens;
+        tokenizeLineUtf8(line, tokens);
+
+        std::vector<std::string> words;
+
+        for (const Token& token : tokens)
+        {
+            words.push_back(line.substr(token.offset, token.length));
+        }
+
+        return words;
+    }
+}
+
+
+TEST(NormalizationTests, tablesMatchTheCLocale)
+{
+    for (unsigned int i = 0; i < 256; ++i)
+    {
+        char c = static_cast<char>(i);
+        bool ascii = i < 0x80;
+
+        EXPECT_EQ(ascii && std::isalnum(i), isWordStart(c)) << i;
+        EXPECT_EQ(ascii && (std::isalnum(i) || c == '-' || c == '\''), isWordPart(c)) << i;
+        EXPECT_EQ(ascii ? std::toupper(i) : static_cast<int>(i),
+                  static_cast<unsigned char>(toUppercase(c))) << i;
+    }
+}
+
+
+TEST(NormalizationTests, uppercaseAsciiLeavesOtherBytesAlone)
+{
+    std::string text;
+
+    for (unsigned int repeat = 0; repeat < 3; ++repeat)
+    {
+        for (unsigned int i = 0; i < 256; ++i)
+        {
+            text.push_back(static_cast<char>(i));
+        }
+    }
+
+    std::string upper(text.length(), '\0');
+    uppercaseAscii(text.data(), text.length(), &upper[0]);
+
+    for (std::size_t i = 0; i < text.length(); ++i)
+    {
+        ASSERT_EQ(toUppercase(text[i]), upper[i]) << i;
+    }
+}
+
+
+TEST(NormalizationTests, normalizeWordUppercasesAndDropsLineEnds)
+{
+    EXPECT_EQ("DON'T", normalizeWord("don't\r"));
+    EXPECT_EQ("X-RAY", normalizeWord("X-ray"));
+    EXPECT_EQ("CAF\xc3\xa9", normalizeWord("caf\xc3\xa9"));
+    EXPECT_EQ("", normalizeWord("\r\n"));
+}
+
+
+TEST(NormalizationTests, decodesValidSequences)
+{
+    char32_t codePoint;
+    std::size_t length;
+
+    ASSERT_TRUE(decodeUtf8("a", 0, codePoint, length));
+    EXPECT_EQ(U'a', codePoint);
+    EXPECT_EQ(1u, length);
+
+    ASSERT_TRUE(decodeUtf8("x\xc3\xa9", 1, codePoint, length));
+    EXPECT_EQ(char32_t{0xE9}, codePoint);
+    EXPECT_EQ(2u, length);
+
+    ASSERT_TRUE(decodeUtf8("\xe6\x97\xa5", 0, codePoint, length));
+    EXPECT_EQ(char32_t{0x65E5}, codePoint);
+    EXPECT_EQ(3u, length);
+
+    ASSERT_TRUE(decodeUtf8("\xf0\x9f\x98\x80", 0, codePoint, length));
+    EXPECT_EQ(char32_t{0x1F600}, codePoint);
+    EXPECT_EQ(4u, length);
+}
+
+
+TEST(NormalizationTests, rejectsInvalidSequences)
+{
+    char32_t codePoint;
+    std::size_t length;
+
+    for (const char* invalid :
+        {"\x80", "\xc3", "\xc0\xaf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff"})
+    {
+        EXPECT_FALSE(decodeUtf8(invalid, 0, codePoint, length)) << invalid;
+        EXPECT_EQ(1u, length);
+    }
+}
+
+
+TEST(NormalizationTests, classifiesNonAsciiLetters)
+{
+    EXPECT_TRUE(isNonAsciiLetter(0xE9));
+    EXPECT_TRUE(isNonAsciiLetter(0x03B1));
+    EXPECT_TRUE(isNonAsciiLetter(0x0436));
+    EXPECT_TRUE(isNonAsciiLetter(0x65E5));
+    EXPECT_FALSE(isNonAsciiLetter(0xD7));
+    EXPECT_FALSE(isNonAsciiLetter(0x2014));
+    EXPECT_FALSE(isNonAsciiLetter(0x1F600));
+}
+
+
+TEST(NormalizationTests, containsNonAsciiChecksEveryByte)
+{
+    std::string text(40, 'a');
+    EXPECT_FALSE(containsNonAscii(text));
+
+    for (std::size_t i = 0; i < text.length(); ++i)
+    {
+        std::string changed = text;
+        changed[i] = '\xc3';
+        EXPECT_TRUE(containsNonAscii(changed)) << i;
+    }
+}
+
+
+TEST(NormalizationTests, utf8TokenizingKeepsNonAsciiLetters)
+{
+    EXPECT_EQ(
+        (std::vector<std::string>{"caf\xc3\xa9", "na\xc3\xafve", "\xce\xb1\xce\xb2"}),
+        utf8Words("caf\xc3\xa9, na\xc3\xafve \xe2\x80\x94 \xce\xb1\xce\xb2'"));
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"a", "b"}),
+        utf8Words("a\xe2\x80\x94" "b\xff"));
+}
+
+
+TEST(NormalizationTests, uppercasesLettersOutsideOfAscii)
+{
+    EXPECT_EQ(char32_t{0xC9}, uppercaseCodePoint(0xE9));
+    EXPECT_EQ(char32_t{0x178}, uppercaseCodePoint(0xFF));
+    EXPECT_EQ(char32_t{0x141}, uppercaseCodePoint(0x142));
+    EXPECT_EQ(char32_t{0x3A3}, uppercaseCodePoint(0x3C2));
+    EXPECT_EQ(char32_t{0x416}, uppercaseCodePoint(0x436));
+    EXPECT_EQ(char32_t{0xDF}, uppercaseCodePoint(0xDF));
+    EXPECT_EQ(char32_t{0x131}, uppercaseCodePoint(0x131));
+    EXPECT_EQ(U'Q', uppercaseCodePoint(U'q'));
+}
+
+
+TEST(NormalizationTests, uppercasingUtf8KeepsTheLength)
+{
+    std::string text = "caf\xc3\xa9 \xd0\xb6\xd1\x91\xd0\xbb \xff stra\xc3\x9f" "e";
+    std::string upper(text.length(), '\0');
+    uppercaseUtf8(text.data(), text.length(), &upper[0]);
+
+    EXPECT_EQ("CAF\xc3\x89 \xd0\x96\xd0\x81\xd0\x9b \xff STRA\xc3\x9f" "E", upper);
+
+    for (char32_t codePoint = 0x80; codePoint < 0x10000; ++codePoint)
+    {
+        if (codePoint < 0xD800 || codePoint > 0xDFFF)
+        {
+            ASSERT_EQ(
+                encodeUtf8(codePoint).length(),
+                encodeUtf8(uppercaseCodePoint(codePoint)).length()) << codePoint;
+        }
+    }
+}
+
+
+TEST(NormalizationTests, normalizeWordCanUppercaseUtf8)
+{
+    EXPECT_EQ("CAF\xc3\x89", normalizeWord("caf\xc3\xa9\r", TextEncoding::Utf8));
+    EXPECT_EQ("CAF\xc3\xa9", normalizeWord("caf\xc3\xa9\r", TextEncoding::Ascii));
+}
@@ -0,0 +1,67 @@
+// ObservableTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the Observable class template, which keeps the list of
+// listeners that a SpellChecker notifies.
+
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include <ics46/observable/Observable.hpp>
+
+
+namespace
+{
+    struct Counter
+    {
+        int count = 0;
+    };
+
+
+    class CounterObservable : public ics46::observable::Observable<Counter>
+    {
+    };
+}
+
+
+TEST(ObservableTests, lockObserversSkipsObserversThatNoLongerExist)
+{
+    std::shared_ptr<Counter> kept = std::make_shared<Counter>();
+    std::shared_ptr<Counter> dropped = std::make_shared<Counter>();
+
+    CounterObservable observable;
+    observable.addObserver(kept);
+    observable.addObserver(dropped);
+    observable.addObserver(kept);
+
+    dropped.reset();
+
+    std::vector<std::shared_ptr<Counter>> locked = observable.lockObservers();
+
+    ASSERT_EQ(1, locked.size());
+    EXPECT_EQ(kept, locked[0]);
+}
+
+
+TEST(ObservableTests, copiesHaveTheirOwnListOfObservers)
+{
+    std::shared_ptr<Counter> first = std::make_shared<Counter>();
+    std::shared_ptr<Counter> second = std::make_shared<Counter>();
+
+    CounterObservable original;
+    original.addObserver(first);
+
+    CounterObservable copy{original};
+    copy.addObserver(second);
+
+    EXPECT_EQ(1, original.lockObservers().size());
+    EXPECT_EQ(2, copy.lockObservers().size());
+
+    original = copy;
+    original.removeObserver(first);
+
+    EXPECT_EQ(1, original.lockObservers().size());
+    EXPECT_EQ(2, copy.lockObservers().size());
+}
@@ -0,0 +1,46 @@
+// SortedDictionaryTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the SortedDictionary, which check that it sorts its
+// words and merges sorted lists of words with them correctly.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SortedDictionary.hpp"
+
+
+TEST(SortedDictionaryTests, wordsAreSortedWithoutDuplicates)
+{
+    SortedDictionary dictionary{{"MAT", "CAT", "THE", "CAT", "ON"}};
+
+    ASSERT_EQ(4, dictionary.size());
+    EXPECT_EQ("CAT", dictionary.word(0));
+    EXPECT_EQ("MAT", dictionary.word(1));
+    EXPECT_EQ("ON", dictionary.word(2));
+    EXPECT_EQ("THE", dictionary.word(3));
+}
+
+
+TEST(SortedDictionaryTests, findsTheWordsThatAreMissing)
+{
+    SortedDictionary dictionary{{"THE", "CAT", "SAT", "ON", "MAT", "CATS"}};
+
+    std::vector<std::string_view> words{"A", "CAT", "CATAPULT", "DOG", "ON", "ZEBRA"};
+
+    EXPECT_EQ(
+        (std::vector<bool>{true, false, true, true, false, true}),
+        dictionary.findMissing(words));
+}
+
+
+TEST(SortedDictionaryTests, everyWordIsMissingFromAnEmptyDictionary)
+{
+    SortedDictionary dictionary{{}};
+
+    EXPECT_EQ(0, dictionary.size());
+    EXPECT_EQ((std::vector<bool>{true, true}), dictionary.findMissing({"CAT", "THE"}));
+}
@@ -0,0 +1,428 @@
+// SpellCheckerTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the SpellChecker's notifications to its listeners.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CopyingSpellCheckerListener.hpp"
+#include "HashSet.hpp"
+#include "SortedDictionary.hpp"
+#include "SpellChecker.hpp"
+#include "StatsSpellCheckerListener.hpp"
+#include "StringHashing.hpp"
+#include "TextFileReader.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    struct Found
+    {
+        std::string text;
+        unsigned long lineNumber;
+        std::size_t lineOffset;
+        std::size_t column;
+        std::vector<std::string> suggestions;
+    };
+
+
+    class PositionListener : public SpellCheckerListener
+    {
+    public:
+        virtual void misspellingFound(
+            const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+        {
+            found.push_back(Found{
+                std::string{misspelling.text()}, misspelling.lineNumber,
+                misspelling.lineOffset, misspelling.column, suggestions});
+        }
+
+        std::vector<Found> found;
+    };
+
+
+    class CopyingListener : public CopyingSpellCheckerListener
+    {
+    public:
+        using CopyingSpellCheckerListener::misspellingFound;
+
+        virtual void misspellingFound(
+            const std::string& word, const std::string& line,
+            const std::vector<std::string>& suggestions)
+        {
+            found.push_back(word + "|" + line);
+        }
+
+        std::vector<std::string> found;
+    };
+
+
+    // A SuggestionCountingListener asks for a given number of suggestions,
+    // and keeps track of the most it's ever been given.
+    class SuggestionCountingListener : public SpellCheckerListener
+    {
+    public:
+        SuggestionCountingListener(std::size_t wanted)
+            : wanted{wanted}, mostGiven{0}
+        {
+        }
+
+        virtual std::size_t maxSuggestions() const
+        {
+            return wanted;
+        }
+
+        virtual void misspellingFound(
+            const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+        {
+            mostGiven = std::max(mostGiven, suggestions.size());
+        }
+
+        std::size_t wanted;
+        std::size_t mostGiven;
+    };
+
+
+    class ThrowingListener : public SpellCheckerListener
+    {
+    public:
+        virtual void misspellingFound(
+            const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+        {
+            throw std::runtime_error{"listener failed"};
+        }
+    };
+
+
+    std::string writeTemporaryFile(const std::string& contents)
+    {
+        std::string path = testing::TempDir() + "SpellCheckerTests.txt";
+        std::ofstream file{path, std::ios::binary};
+        file << contents;
+        return path;
+    }
+
+
+    std::vector<std::string> dictionaryWords()
+    {
+        return {"THE", "CAT", "SAT", "ON", "MAT"};
+    }
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{hashStringAsProduct};
+
+        for (const std::string& word : dictionaryWords())
+        {
+            words.add(word);
+        }
+
+        return words;
+    }
+
+
+    // The ways that check() can run a SpellChecker.
+    enum class RunMode
+    {
+        Sequential,
+        Parallel,
+        Pipelined,
+        Distinct,
+        SortMerge
+    };
+
+
+    // check() checks the text in the given way, with the given listeners,
+    // against the words from makeWords().  The thread count is used by the
+    // modes that use more than one thread.
+    void check(
+        const std::string& text,
+        const std::vector<std::shared_ptr<SpellCheckerListener>>& listeners,
+        RunMode runMode = RunMode::Sequential, unsigned int threadCount = 1,
+        NotificationMode notificationMode = NotificationMode::Immediate)
+    {
+        HashSet<std::string> words = makeWords();
+        SortedDictionary dictionary{dictionaryWords()};
+        std::string path = writeTemporaryFile(text);
+
+        {
+            SpellChecker spellChecker;
+            spellChecker.setNotificationMode(notificationMode);
+
+            for (const std::shared_ptr<SpellCheckerListener>& listener : listeners)
+            {
+                spellChecker.addObserver(listener);
+            }
+
+            WordChecker wordChecker{words};
+            TextFileReader reader{path};
+
+            switch (runMode)
+            {
+            case RunMode::Sequential:
+                spellChecker.run(wordChecker, reader);
+                break;
+
+            case RunMode::Parallel:
+                spellChecker.runParallel(wordChecker, path, threadCount);
+                break;
+
+            case RunMode::Pipelined:
+                spellChecker.runPipelined(wordChecker, reader, threadCount);
+                break;
+
+            case RunMode::Distinct:
+                spellChecker.runDistinct(wordChecker, reader);
+                break;
+
+            case RunMode::SortMerge:
+                spellChecker.runSortMerge(wordChecker, dictionary, path, threadCount);
+                break;
+            }
+        }
+
+        std::remove(path.c_str());
+    }
+
+
+    void check(
+        const std::string& text, std::shared_ptr<SpellCheckerListener> listener,
+        RunMode runMode = RunMode::Sequential, unsigned int threadCount = 1,
+        NotificationMode notificationMode = NotificationMode::Immediate)
+    {
+        check(text, std::vector{listener}, runMode, threadCount, notificationMode);
+    }
+
+
+    // expectSameMisspellings() checks the text sequentially and in the
+    // given way, expecting the same misspellings in the same order.
+    void expectSameMisspellings(
+        const std::string& text, RunMode runMode, unsigned int threadCount = 1,
+        NotificationMode notificationMode = NotificationMode::Immediate)
+    {
+        std::shared_ptr<PositionListener> expected = std::make_shared<PositionListener>();
+        check(text, expected);
+
+        std::shared_ptr<PositionListener> actual = std::make_shared<PositionListener>();
+        check(text, actual, runMode, threadCount, notificationMode);
+
+        ASSERT_EQ(expected->found.size(), actual->found.size());
+
+        for (std::size_t i = 0; i < expected->found.size(); ++i)
+        {
+            ASSERT_EQ(expected->found[i].text, actual->found[i].text) << i;
+            ASSERT_EQ(expected->found[i].lineNumber, actual->found[i].lineNumber) << i;
+            ASSERT_EQ(expected->found[i].lineOffset, actual->found[i].lineOffset) << i;
+            ASSERT_EQ(expected->found[i].column, actual->found[i].column) << i;
+            ASSERT_EQ(expected->found[i].suggestions, actual->found[i].suggestions) << i;
+        }
+    }
+}
+
+
+TEST(SpellCheckerTests, misspellingsCarryTheirPositions)
+{
+    std::shared_ptr<PositionListener> listener = std::make_shared<PositionListener>();
+    check("The cat sta\n\n  on teh Mat, dgo\n", listener);
+
+    ASSERT_EQ(3, listener->found.size());
+
+    EXPECT_EQ("sta", listener->found[0].text);
+    EXPECT_EQ(1, listener->found[0].lineNumber);
+    EXPECT_EQ(0, listener->found[0].lineOffset);
+    EXPECT_EQ(8, listener->found[0].column);
+
+    EXPECT_EQ("teh", listener->found[1].text);
+    EXPECT_EQ(3, listener->found[1].lineNumber);
+    EXPECT_EQ(13, listener->found[1].lineOffset);
+    EXPECT_EQ(5, listener->found[1].column);
+
+    EXPECT_EQ("dgo", listener->found[2].text);
+    EXPECT_EQ(3, listener->found[2].lineNumber);
+    EXPECT_EQ(14, listener->found[2].column);
+}
+
+
+TEST(SpellCheckerTests, listenersCanStillReceiveCopies)
+{
+    std::shared_ptr<CopyingListener> listener = std::make_shared<CopyingListener>();
+    check("the cta sat\non teh mat", listener);
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"CTA|the cta sat", "TEH|on teh mat"}),
+        listener->found);
+}
+
+
+TEST(SpellCheckerTests, parallelRunsFindTheSameMisspellingsInOrder)
+{
+    std::string text;
+
+    for (unsigned int i = 0; i < 500; ++i)
+    {
+        text += "the cat sat on teh mat\n";
+        text += (i % 7 == 0) ? "\n" : "  a dgo" + std::to_string(i) + " sat\n";
+    }
+
+    for (unsigned int threadCount : {2, 3, 8})
+    {
+        expectSameMisspellings(text, RunMode::Parallel, threadCount);
+    }
+}
+
+
+TEST(SpellCheckerTests, pipelinedRunsFindTheSameMisspellingsInOrder)
+{
+    std::string text;
+
+    for (unsigned int i = 0; i < 3000; ++i)
+    {
+        text += "teh cat sat on teh mat dgo" + std::to_string(i % 10) + "\n";
+    }
+
+    for (unsigned int checkerCount : {1, 4})
+    {
+        expectSameMisspellings(text, RunMode::Pipelined, checkerCount);
+    }
+}
+
+
+TEST(SpellCheckerTests, batchedNotificationsArriveInTheSameOrder)
+{
+    std::string text;
+
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        text += "teh cat sat on teh mat\n";
+    }
+
+    for (NotificationMode mode : {NotificationMode::Batched, NotificationMode::DedicatedThread})
+    {
+        for (RunMode runMode : {RunMode::Parallel, RunMode::Pipelined})
+        {
+            expectSameMisspellings(text, runMode, 2, mode);
+        }
+    }
+}
+
+
+TEST(SpellCheckerTests, listenerExceptionsReachTheCallerFromTheirOwnThread)
+{
+    std::string text;
+
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        text += "teh cat sat\n";
+    }
+
+    EXPECT_THROW(
+        check(text, std::make_shared<ThrowingListener>(), RunMode::Sequential, 1,
+              NotificationMode::DedicatedThread),
+        std::runtime_error);
+}
+
+
+TEST(SpellCheckerTests, suggestionsAreOnlyFoundForListenersThatNeedThem)
+{
+    // "DAT" has three suggestions ("CAT", "SAT", and "MAT"), and "TEH"
+    // has one.
+    std::string text = "the sat dat on teh mat\n";
+
+    std::shared_ptr<SuggestionCountingListener> none =
+        std::make_shared<SuggestionCountingListener>(0);
+    check(text, none);
+    EXPECT_EQ(0, none->mostGiven);
+
+    std::shared_ptr<SuggestionCountingListener> one =
+        std::make_shared<SuggestionCountingListener>(1);
+    check(text, one);
+    EXPECT_EQ(1, one->mostGiven);
+
+    // With two listeners, both are given as many as the more demanding one
+    // asked for.
+    std::shared_ptr<SuggestionCountingListener> both =
+        std::make_shared<SuggestionCountingListener>(0);
+    std::shared_ptr<SuggestionCountingListener> all =
+        std::make_shared<SuggestionCountingListener>(SpellCheckerListener::ALL_SUGGESTIONS);
+
+    check(text, {both, all});
+
+    EXPECT_EQ(3, all->mostGiven);
+    EXPECT_EQ(3, both->mostGiven);
+}
+
+
+TEST(SpellCheckerTests, listenersAreToldHowManyWordsWereChecked)
+{
+    std::string text;
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        text += "the cat sta on teh mat\n";
+    }
+
+    for (RunMode runMode :
+         {RunMode::Sequential, RunMode::Parallel, RunMode::Pipelined,
+          RunMode::Distinct, RunMode::SortMerge})
+    {
+        std::ostringstream out;
+        std::shared_ptr<StatsSpellCheckerListener> listener =
+            std::make_shared<StatsSpellCheckerListener>(out);
+
+        check(text, listener, runMode, 3);
+
+        EXPECT_EQ(6000, listener->wordCount());
+        EXPECT_EQ(2000, listener->misspellingCount());
+        EXPECT_EQ(2, listener->distinctMisspellingCount());
+    }
+}
+
+
+TEST(SpellCheckerTests, distinctRunsReportEveryOccurrenceOfEachMisspelling)
+{
+    std::string text;
+
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        text += "teh cat sat on teh mat dgo" + std::to_string(i % 10) + "\n";
+    }
+
+    expectSameMisspellings(text, RunMode::Distinct);
+
+    std::ostringstream out;
+    std::shared_ptr<StatsSpellCheckerListener> stats =
+        std::make_shared<StatsSpellCheckerListener>(out);
+
+    check(text, stats, RunMode::Distinct);
+
+    EXPECT_EQ(700, stats->wordCount());
+    EXPECT_EQ(300, stats->misspellingCount());
+    EXPECT_EQ(11, stats->distinctMisspellingCount());
+}
+
+
+TEST(SpellCheckerTests, sortMergeRunsFindTheSameMisspellingsInOrder)
+{
+    std::string text;
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        text += "teh cat sat on teh mat dgo" + std::to_string(i % 100) + "\n";
+    }
+
+    for (unsigned int threadCount : {1, 3})
+    {
+        expectSameMisspellings(text, RunMode::SortMerge, threadCount);
+    }
+}
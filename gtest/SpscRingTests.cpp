@@ -0,0 +1,72 @@
+// SpscRingTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the SpscRing, on its own and with a producer and
+// consumer running on separate threads.
+
+#include <thread>
+#include <gtest/gtest.h>
+#include "SpscRing.hpp"
+
+
+TEST(SpscRingTests, capacityIsRoundedUpToAPowerOfTwo)
+{
+    SpscRing<int> ring{5};
+    EXPECT_EQ(8, ring.capacity());
+}
+
+
+TEST(SpscRingTests, pushingFailsWhenFull)
+{
+    SpscRing<int> ring{4};
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.tryPush(i));
+    }
+
+    int extra = 4;
+    EXPECT_FALSE(ring.tryPush(extra));
+
+    int value;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(0, value);
+    EXPECT_TRUE(ring.tryPush(extra));
+}
+
+
+TEST(SpscRingTests, valuesArriveInOrderAcrossThreads)
+{
+    SpscRing<int> ring{16};
+    const int count = 100000;
+
+    std::thread producer{
+        [&]()
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                int value = i;
+
+                while (!ring.tryPush(value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }};
+
+    for (int expected = 0; expected < count; ++expected)
+    {
+        int value;
+
+        while (!ring.tryPop(value))
+        {
+            std::this_thread::yield();
+        }
+
+        ASSERT_EQ(expected, value);
+    }
+
+    producer.join();
+}
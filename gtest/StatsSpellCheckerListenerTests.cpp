@@ -0,0 +1,76 @@
+// StatsSpellCheckerListenerTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the StatsSpellCheckerListener, which check what it
+// counts and the report it writes once checking is finished.
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "StatsSpellCheckerListener.hpp"
+
+
+namespace
+{
+    void misspell(StatsSpellCheckerListener& listener, const std::string& word)
+    {
+        listener.misspellingFound(Misspelling{word, word, 1, 0, 0, word.length()}, {});
+    }
+}
+
+
+TEST(StatsSpellCheckerListenerTests, countsMisspellingsByWord)
+{
+    std::ostringstream out;
+    StatsSpellCheckerListener listener{out};
+
+    for (const char* word : {"TEH", "CTA", "TEH", "DGO", "CTA", "TEH"})
+    {
+        misspell(listener, word);
+    }
+
+    listener.wordsChecked(20);
+
+    EXPECT_EQ(0, listener.maxSuggestions());
+    EXPECT_EQ(20, listener.wordCount());
+    EXPECT_EQ(6, listener.misspellingCount());
+    EXPECT_EQ(3, listener.distinctMisspellingCount());
+
+    // Ties are broken alphabetically.
+    EXPECT_EQ(
+        (std::vector<std::pair<std::string, unsigned long>>{{"TEH", 3}, {"CTA", 2}}),
+        listener.mostFrequentMisspellings(2));
+
+    EXPECT_EQ(3, listener.mostFrequentMisspellings(100).size());
+    EXPECT_EQ("", out.str());
+}
+
+
+TEST(StatsSpellCheckerListenerTests, reportsOnlyWhenCheckingIsFinished)
+{
+    std::ostringstream out;
+    StatsSpellCheckerListener listener{out, 2};
+
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        misspell(listener, "TEH");
+    }
+
+    misspell(listener, "DGO");
+    misspell(listener, "CTA");
+    listener.wordsChecked(100);
+    listener.checkingFinished();
+
+    EXPECT_EQ(
+        "Words checked: 100\n"
+        "Misspellings: 14\n"
+        "Distinct misspelled words: 3\n"
+        "Most frequent misspellings:\n"
+        "    12  TEH\n"
+        "     1  CTA\n",
+        out.str());
+}
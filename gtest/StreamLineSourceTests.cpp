@@ -0,0 +1,115 @@
+// StreamLineSourceTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the StreamLineSource, which feed it text through a pipe
+// using chunks small enough that lines and words are cut off by the ends
+// of chunks.
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "StreamLineSource.hpp"
+#include "TextReader.hpp"
+
+
+namespace
+{
+    // writeToPipe() returns the read end of a pipe that's being fed the
+    // given text by the returned thread, a few bytes at a time.
+    int writeToPipe(const std::string& text, std::thread& writer)
+    {
+        int descriptors[2];
+
+        if (::pipe(descriptors) != 0)
+        {
+            return -1;
+        }
+
+        int writeEnd = descriptors[1];
+
+        writer = std::thread{
+            [text, writeEnd]
+            {
+                for (std::size_t i = 0; i < text.length(); i += 5)
+                {
+                    std::string_view piece = std::string_view{text}.substr(i, 5);
+                    ssize_t written = ::write(writeEnd, piece.data(), piece.length());
+                    (void) written;
+                }
+
+                ::close(writeEnd);
+            }};
+
+        return descriptors[0];
+    }
+
+
+    std::vector<std::string> readLines(const std::string& text, std::size_t chunkSize)
+    {
+        std::thread writer;
+        StreamLineSource source{writeToPipe(text, writer), true, chunkSize};
+
+        std::vector<std::string> lines;
+        std::string_view line;
+
+        while (source.nextLine(line))
+        {
+            lines.emplace_back(line);
+        }
+
+        writer.join();
+        return lines;
+    }
+}
+
+
+TEST(StreamLineSourceTests, producesLinesCutOffByChunks)
+{
+    EXPECT_EQ(
+        (std::vector<std::string>{"the quick", "", "brown fox jumps", "over"}),
+        readLines("the quick\n\nbrown fox jumps\nover", 4));
+}
+
+
+TEST(StreamLineSourceTests, trailingNewlineDoesNotAddALine)
+{
+    EXPECT_EQ((std::vector<std::string>{"one", "two"}), readLines("one\ntwo\n", 3));
+    EXPECT_TRUE(readLines("", 3).empty());
+}
+
+
+TEST(StreamLineSourceTests, linesLongerThanAChunkAreKeptWhole)
+{
+    std::string longLine(1000, 'x');
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"a", longLine, "b"}),
+        readLines("a\n" + longLine + "\nb\n", 16));
+}
+
+
+TEST(StreamLineSourceTests, wordsCutOffByChunksAreReadWhole)
+{
+    std::thread writer;
+    TextReader reader{std::make_unique<StreamLineSource>(
+        writeToPipe("Spelling checkers\ncarry partial-words across\n", writer), true, 7)};
+
+    std::vector<std::string> words;
+
+    for (; !reader.noMoreWords(); reader.advanceToNextWord())
+    {
+        words.push_back(reader.currentWord());
+    }
+
+    writer.join();
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"SPELLING", "CHECKERS", "CARRY", "PARTIAL-WORDS", "ACROSS"}),
+        words);
+}
@@ -0,0 +1,78 @@
+// SuggestionCacheTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the SuggestionCache, which remembers the suggestions
+// generated for recently-seen misspellings.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "SuggestionCache.hpp"
+#include "WordChecker.hpp"
+
+
+TEST(SuggestionCacheTests, missesThenHitsOnRepeatedWord)
+{
+    HashSet<std::string> words{hashStringAsProduct};
+    words.add("CAT");
+    words.add("CART");
+    WordChecker checker{words};
+
+    SuggestionCache cache{4};
+
+    std::vector<std::string> first = cache.findSuggestions(checker, "CAAT");
+    std::vector<std::string> second = cache.findSuggestions(checker, "CAAT");
+
+    EXPECT_EQ(checker.findSuggestions("CAAT"), first);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1u, cache.misses());
+    EXPECT_EQ(1u, cache.hits());
+}
+
+
+TEST(SuggestionCacheTests, neverGrowsBeyondCapacity)
+{
+    SuggestionCache cache{2};
+
+    cache.store("A", {"X"});
+    cache.store("B", {"Y"});
+    cache.store("C", {"Z"});
+
+    EXPECT_EQ(2u, cache.size());
+
+    std::vector<std::string> suggestions;
+    EXPECT_TRUE(cache.lookup("C", suggestions));
+    EXPECT_EQ(std::vector<std::string>{"Z"}, suggestions);
+}
+
+
+TEST(SuggestionCacheTests, evictsUnreferencedEntriesFirst)
+{
+    SuggestionCache cache{2};
+    std::vector<std::string> suggestions;
+
+    cache.store("A", {"X"});
+    cache.store("B", {"Y"});
+    cache.lookup("A", suggestions);
+    cache.store("C", {"Z"});
+
+    EXPECT_TRUE(cache.lookup("A", suggestions));
+    EXPECT_FALSE(cache.lookup("B", suggestions));
+    EXPECT_TRUE(cache.lookup("C", suggestions));
+}
+
+
+TEST(SuggestionCacheTests, zeroCapacityStoresNothing)
+{
+    SuggestionCache cache{0};
+    std::vector<std::string> suggestions;
+
+    cache.store("A", {"X"});
+
+    EXPECT_FALSE(cache.lookup("A", suggestions));
+    EXPECT_EQ(0u, cache.size());
+}
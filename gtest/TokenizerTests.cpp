@@ -0,0 +1,110 @@
+// TokenizerTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for tokenizeLine() and uppercaseLine(), which compare them
+// against a straightforward, one-character-at-a-time implementation of
+// the same rules.
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Tokenizer.hpp"
+
+
+namespace
+{
+    std::vector<std::string> referenceWords(const std::string& line)
+    {
+        std::vector<std::string> words;
+        std::size_t i = 0;
+
+        while (true)
+        {
+            while (i < line.length() && !std::isalnum(static_cast<unsigned char>(line[i])))
+            {
+                ++i;
+            }
+
+            if (i >= line.length())
+            {
+                return words;
+            }
+
+            std::string word;
+
+            while (i < line.length()
+                && (std::isalnum(static_cast<unsigned char>(line[i]))
+                    || line[i] == '-' || line[i] == '\''))
+            {
+                word.push_back(std::toupper(static_cast<unsigned char>(line[i++])));
+            }
+
+            if (!std::isalnum(static_cast<unsigned char>(word.back())))
+            {
+                word.pop_back();
+            }
+
+            words.push_back(word);
+        }
+    }
+
+
+    std::vector<std::string> tokenizedWords(const std::string& line)
+    {
+        std::vector<Token> tokens;
+        tokenizeLine(line, tokens);
+
+        std::string upper;
+        uppercaseLine(line, upper);
+
+        std::vector<std::string> words;
+
+        for (const Token& token : tokens)
+        {
+            words.push_back(upper.substr(token.offset, token.length));
+        }
+
+        return words;
+    }
+}
+
+
+TEST(TokenizerTests, trimsOneTrailingHyphenOrApostrophe)
+{
+    EXPECT_EQ(
+        (std::vector<std::string>{"DON'T", "ROCK-N-ROLL", "ABC-", "X", "Y"}),
+        tokenizedWords("don't rock-n-roll --abc-- x' -'-y"));
+}
+
+
+TEST(TokenizerTests, emptyAndWordlessLines)
+{
+    EXPECT_TRUE(tokenizedWords("").empty());
+    EXPECT_TRUE(tokenizedWords(" -- '' ,.;\r").empty());
+}
+
+
+TEST(TokenizerTests, matchesReferenceOnRandomLines)
+{
+    const std::string alphabet = "abcXYZ09-'' \t.,\r\xc3\xa9\xff";
+
+    std::mt19937 random{46};
+    std::uniform_int_distribution<std::size_t> lengthDistribution{0, 300};
+    std::uniform_int_distribution<std::size_t> charDistribution{0, alphabet.length() - 1};
+
+    for (unsigned int trial = 0; trial < 2000; ++trial)
+    {
+        std::string line(lengthDistribution(random), ' ');
+
+        for (char& c : line)
+        {
+            c = alphabet[charDistribution(random)];
+        }
+
+        ASSERT_EQ(referenceWords(line), tokenizedWords(line)) << line;
+    }
+}
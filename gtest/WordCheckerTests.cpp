@@ -0,0 +1,148 @@
+// WordCheckerTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WordChecker's suggestions, beyond the sanity checks.
+// In particular, these make sure that the different ways WordChecker can
+// find suggestions all agree with one another.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    const std::vector<std::string> WORDS{
+        "AS", "ASS", "ADS", "AM", "RAM", "YAM", "HAM", "CAT", "CART", "ACT",
+        "AT", "A", "I", "CAST", "SCAT", "CHAT"};
+
+    const std::vector<std::string> QUERIES{
+        "A'S", "AAM", "CTA", "CAAT", "CATT", "ATCAT", "C", "ZZZ", "HCAT", "TAC"};
+
+
+    template <typename Set>
+    void addWords(Set& s)
+    {
+        for (const std::string& word : WORDS)
+        {
+            s.add(word);
+        }
+    }
+}
+
+
+TEST(WordCheckerTests, hashedSuggestionsMatchGeneralSuggestions)
+{
+    // A set hashing with hashStringAsProduct() takes the incremental
+    // hashing path; one hashing with hashStringAsSum() doesn't.
+    HashSet<std::string> productSet{hashStringAsProduct};
+    HashSet<std::string> sumSet{hashStringAsSum};
+    addWords(productSet);
+    addWords(sumSet);
+
+    WordChecker hashed{productSet};
+    WordChecker general{sumSet};
+
+    for (const std::string& query : QUERIES)
+    {
+        EXPECT_EQ(general.findSuggestions(query), hashed.findSuggestions(query)) << query;
+    }
+}
+
+
+TEST(WordCheckerTests, suggestionsIncludeEachEditExactlyOnce)
+{
+    HashSet<std::string> s{hashStringAsProduct};
+    addWords(s);
+
+    WordChecker checker{s};
+
+    std::vector<std::string> expected{"CAT", "ACT", "AT", "CART", "CAST", "CHAT", "SCAT"};
+    std::vector<std::string> suggestions = checker.findSuggestions("CAT");
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(suggestions.begin(), suggestions.end());
+
+    EXPECT_EQ(expected, suggestions);
+    EXPECT_EQ("CAT", checker.findSuggestions("CTA")[0]);
+}
+
+
+TEST(WordCheckerTests, suggestionsCanUseAddedLetters)
+{
+    HashSet<std::string> productSet{hashStringAsProduct};
+    HashSet<std::string> sumSet{hashStringAsSum};
+
+    for (const char* word : {"CAF\xc3\x89", "\xc3\x89T\xc3\x89", "CAFE"})
+    {
+        productSet.add(word);
+        sumSet.add(word);
+    }
+
+    WordChecker hashed{productSet};
+    WordChecker general{sumSet};
+    hashed.addLetters({"\xc3\x89"});
+    general.addLetters({"\xc3\x89"});
+
+    // Replacing a letter with an added one, deleting a whole two-byte
+    // character, and swapping one with its neighbor.
+    EXPECT_EQ(
+        (std::vector<std::string>{"CAFE", "CAF\xc3\x89"}), hashed.findSuggestions("CAFF"));
+    EXPECT_EQ(
+        (std::vector<std::string>{"CAF\xc3\x89"}), hashed.findSuggestions("CAF\xc3\x89\xc3\x89"));
+    EXPECT_EQ(
+        (std::vector<std::string>{"\xc3\x89T\xc3\x89"}), hashed.findSuggestions("T\xc3\x89\xc3\x89"));
+
+    for (const char* query :
+        {"CAFF", "CAF\xc3\x89\xc3\x89", "T\xc3\x89\xc3\x89", "\xc3\x89" "CAF", "CAF\xc3"})
+    {
+        EXPECT_EQ(general.findSuggestions(query), hashed.findSuggestions(query)) << query;
+    }
+}
+
+
+TEST(WordCheckerTests, addingLettersKeepsTheOrderOfOtherSuggestions)
+{
+    HashSet<std::string> s{hashStringAsProduct};
+    addWords(s);
+
+    WordChecker plain{s};
+    WordChecker widened{s};
+    widened.addLetters({"\xc3\x89", "\xc3\x96"});
+
+    for (const std::string& query : QUERIES)
+    {
+        EXPECT_EQ(plain.findSuggestions(query), widened.findSuggestions(query)) << query;
+    }
+}
+
+
+TEST(WordCheckerTests, limitedSuggestionsAreTheFirstOnes)
+{
+    HashSet<std::string> productSet{hashStringAsProduct};
+    HashSet<std::string> sumSet{hashStringAsSum};
+    addWords(productSet);
+    addWords(sumSet);
+
+    for (const WordChecker& checker : {WordChecker{productSet}, WordChecker{sumSet}})
+    {
+        for (const std::string& query : QUERIES)
+        {
+            std::vector<std::string> all = checker.findSuggestions(query);
+
+            for (std::size_t maxCount = 0; maxCount <= all.size() + 1; ++maxCount)
+            {
+                std::vector<std::string> expected{
+                    all.begin(), all.begin() + std::min(maxCount, all.size())};
+
+                EXPECT_EQ(expected, checker.findSuggestions(query, maxCount)) << query;
+            }
+        }
+    }
+}
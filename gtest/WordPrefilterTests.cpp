@@ -0,0 +1,97 @@
+// WordPrefilterTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WordPrefilter, which rules out most words that are
+// not in a word set with a few bit tests.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "WordChecker.hpp"
+#include "WordPrefilter.hpp"
+
+
+TEST(WordPrefilterTests, mayContainEveryAddedWord)
+{
+    std::vector<std::string> words{"CAT", "DOG", "A", "DON'T", "X-RAY", "ABBA"};
+    WordPrefilter prefilter;
+
+    for (const std::string& word : words)
+    {
+        prefilter.add(word);
+    }
+
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(prefilter.mayContain(word)) << word;
+    }
+
+    EXPECT_EQ(words.size(), prefilter.size());
+}
+
+
+TEST(WordPrefilterTests, rulesOutUnseenLengths)
+{
+    WordPrefilter prefilter;
+    prefilter.add("CAT");
+
+    EXPECT_FALSE(prefilter.mayContain(""));
+    EXPECT_FALSE(prefilter.mayContain("CA"));
+    EXPECT_FALSE(prefilter.mayContain("CATS"));
+}
+
+
+TEST(WordPrefilterTests, rulesOutLettersNeverSeenAtAPosition)
+{
+    WordPrefilter prefilter;
+    prefilter.add("CAT");
+    prefilter.add("DOG");
+
+    EXPECT_FALSE(prefilter.mayContain("ACT"));
+    EXPECT_FALSE(prefilter.mayContain("CAZ"));
+}
+
+
+TEST(WordPrefilterTests, rulesOutUnseenLetterCombinations)
+{
+    WordPrefilter prefilter;
+    prefilter.add("CAT");
+    prefilter.add("DOG");
+
+    // Every letter appears at its position in some word, but no word has
+    // exactly these letters.
+    EXPECT_FALSE(prefilter.mayContain("COG"));
+    EXPECT_TRUE(prefilter.mayContain("CAT"));
+}
+
+
+TEST(WordPrefilterTests, doesNotChangeSuggestions)
+{
+    std::vector<std::string> words{"AS", "ASS", "ADS", "CAT", "CART", "ACT", "AT", "SCAT"};
+
+    HashSet<std::string> productSet{hashStringAsProduct};
+    HashSet<std::string> sumSet{hashStringAsSum};
+    WordPrefilter prefilter;
+
+    for (const std::string& word : words)
+    {
+        productSet.add(word);
+        sumSet.add(word);
+        prefilter.add(word);
+    }
+
+    WordChecker plain{productSet};
+    WordChecker hashed{productSet, prefilter};
+    WordChecker general{sumSet, prefilter};
+
+    for (const char* query : {"A'S", "CTA", "CAAT", "CATT", "ZZZ", "AAS"})
+    {
+        EXPECT_EQ(plain.findSuggestions(query), hashed.findSuggestions(query)) << query;
+        EXPECT_EQ(plain.findSuggestions(query), general.findSuggestions(query)) << query;
+        EXPECT_EQ(plain.wordExists(query), hashed.wordExists(query)) << query;
+    }
+}
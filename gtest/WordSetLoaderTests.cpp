@@ -0,0 +1,150 @@
+// WordSetLoaderTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WordSetLoader and for adding words to sets in bulk
+// with addAll().
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "EmbeddedSet.hpp"
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+namespace
+{
+    std::string writeTemporaryFile(const std::string& contents)
+    {
+        std::string path = testing::TempDir() + "WordSetLoaderTests.txt";
+        std::ofstream file{path, std::ios::binary};
+        file << contents;
+        return path;
+    }
+
+
+    std::vector<std::string> manyWords(unsigned int count)
+    {
+        std::vector<std::string> words;
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            // Every word appears twice, to be sure the duplicates are ignored.
+            words.push_back("W" + std::to_string(i % (count / 2)));
+        }
+
+        return words;
+    }
+}
+
+
+TEST(WordSetLoaderTests, readsUppercasedWordsWithoutCarriageReturns)
+{
+    std::string path = writeTemporaryFile("apple\r\nBanana\n\ndon't\r\nx-ray");
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"APPLE", "BANANA", "", "DON'T", "X-RAY"}),
+        WordSetLoader{}.readWords(path));
+
+    std::remove(path.c_str());
+}
+
+
+TEST(WordSetLoaderTests, throwsWhenTheFileCannotBeOpened)
+{
+    std::string path = testing::TempDir() + "WordSetLoaderTests-missing.txt";
+    std::remove(path.c_str());
+
+    EXPECT_THROW(WordSetLoader{}.readWords(path), WordSetLoader::FileException);
+    EXPECT_THROW(WordSetLoader{true}.readWords(path), WordSetLoader::FileException);
+}
+
+
+TEST(WordSetLoaderTests, loadedWordsOfAnEmbeddedSetNeedNoFile)
+{
+    std::string path = testing::TempDir() + "WordSetLoaderTests-missing.txt";
+    std::remove(path.c_str());
+
+    EmbeddedSet set;
+    WordSetLoader loader;
+    loader.load(path, set);
+
+    std::vector<std::string> words = loader.loadedWords(path, set);
+
+    ASSERT_EQ(EmbeddedSet::embeddedSize(), words.size());
+
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(set.contains(word)) << word;
+    }
+}
+
+
+TEST(WordSetLoaderTests, readsUtf8WordsAndCollectsTheirAlphabet)
+{
+    std::string path = writeTemporaryFile("caf\xc3\xa9\n\xc3\xa9t\xc3\xa9\nna\xc3\xafve\nplain");
+
+    WordSetLoader loader{false, TextEncoding::Utf8};
+    HashSet<std::string> s{hashStringAsProduct};
+    loader.load(path, s);
+
+    EXPECT_TRUE(s.contains("CAF\xc3\x89"));
+    EXPECT_TRUE(s.contains("NA\xc3\x8fVE"));
+    EXPECT_EQ((std::vector<std::string>{"\xc3\x89", "\xc3\x8f"}), loader.alphabet());
+
+    WordSetLoader asciiLoader;
+    EXPECT_EQ("CAF\xc3\xa9", asciiLoader.readWords(path)[0]);
+    EXPECT_TRUE(asciiLoader.alphabet().empty());
+
+    std::remove(path.c_str());
+}
+
+
+TEST(WordSetLoaderTests, readsWordsAcrossChunksInOrder)
+{
+    std::string contents;
+    std::vector<std::string> expected;
+
+    for (unsigned int i = 0; i < 200000; ++i)
+    {
+        contents += "word" + std::to_string(i) + "\n";
+        expected.push_back("WORD" + std::to_string(i));
+    }
+
+    std::string path = writeTemporaryFile(contents);
+    EXPECT_EQ(expected, WordSetLoader{}.readWords(path));
+    std::remove(path.c_str());
+}
+
+
+TEST(WordSetLoaderTests, addAllMatchesAddingOneAtATime)
+{
+    std::vector<std::string> words = manyWords(4 * HashSet<std::string>::PARALLEL_ADD_MINIMUM);
+
+    HashSet<std::string> oneAtATime{hashStringAsProduct};
+
+    for (const std::string& word : words)
+    {
+        oneAtATime.add(word);
+    }
+
+    HashSet<std::string> all{hashStringAsProduct};
+    all.add("W0");
+    all.add("SOMETHING ELSE");
+    all.addAll(words.data(), words.size());
+
+    EXPECT_EQ(oneAtATime.size() + 1, all.size());
+
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(all.contains(word)) << word;
+    }
+
+    EXPECT_TRUE(all.contains("SOMETHING ELSE"));
+    EXPECT_FALSE(all.contains("W-1"));
+}
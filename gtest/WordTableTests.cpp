@@ -0,0 +1,63 @@
+// WordTableTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WordTable, which check that words keep the indexes
+// they were first given as the table grows.
+
+#include <string>
+#include <gtest/gtest.h>
+#include "WordTable.hpp"
+
+
+TEST(WordTableTests, wordsAreIndexedInTheOrderTheyWereFirstAdded)
+{
+    WordTable table;
+
+    EXPECT_EQ(0, table.insert("TEH"));
+    EXPECT_EQ(1, table.insert("CTA"));
+    EXPECT_EQ(0, table.insert("TEH"));
+    EXPECT_EQ(2, table.insert(""));
+
+    EXPECT_EQ(3, table.size());
+    EXPECT_EQ("CTA", table.word(1));
+    EXPECT_EQ(1, table.find("CTA"));
+    EXPECT_EQ(WordTable::NOT_FOUND, table.find("DGO"));
+}
+
+
+TEST(WordTableTests, wordsKeepTheirIndexesAsTheTableGrows)
+{
+    WordTable table;
+
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+        ASSERT_EQ(i, table.insert("WORD" + std::to_string(i)));
+    }
+
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+        std::string word = "WORD" + std::to_string(i);
+
+        ASSERT_EQ(i, table.find(word));
+        ASSERT_EQ(word, table.word(i));
+    }
+}
+
+
+TEST(WordTableTests, clearingRemovesEveryWord)
+{
+    WordTable table;
+
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        table.insert(std::to_string(i));
+    }
+
+    table.clear();
+
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(WordTable::NOT_FOUND, table.find("42"));
+    EXPECT_EQ(0, table.insert("42"));
+}
@@ -0,0 +1,69 @@
+// WorkStealingPoolTests.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WorkStealingPool, which check that every task runs
+// exactly once, however uneven their costs, and that a task's exception
+// reaches the caller.
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "WorkStealingPool.hpp"
+
+
+TEST(WorkStealingPoolTests, runsEveryTaskOnce)
+{
+    std::vector<std::size_t> costs;
+
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        costs.push_back(i % 10 == 0 ? 1000000 : i);
+    }
+
+    std::unique_ptr<std::atomic<int>[]> runs{new std::atomic<int>[costs.size()]};
+
+    for (std::size_t i = 0; i < costs.size(); ++i)
+    {
+        runs[i] = 0;
+    }
+
+    for (unsigned int threadCount : {1, 2, 7})
+    {
+        WorkStealingPool pool{threadCount};
+        pool.run(costs, [&](std::size_t index) { ++runs[index]; });
+    }
+
+    for (std::size_t i = 0; i < costs.size(); ++i)
+    {
+        ASSERT_EQ(3, runs[i]) << i;
+    }
+}
+
+
+TEST(WorkStealingPoolTests, runsNothingWithoutTasks)
+{
+    WorkStealingPool pool{4};
+    pool.run({}, [](std::size_t) { FAIL(); });
+}
+
+
+TEST(WorkStealingPoolTests, rethrowsATasksException)
+{
+    WorkStealingPool pool{3};
+
+    EXPECT_THROW(
+        pool.run(
+            std::vector<std::size_t>(100, 1),
+            [](std::size_t index)
+            {
+                if (index == 42)
+                {
+                    throw std::runtime_error{"task failed"};
+                }
+            }),
+        std::runtime_error);
+}
@@ -7,6 +7,22 @@
 // that provides the ability for an object to have a list of "observer"
 // objects associated with it, which can be "notified" when an interesting
 // event occurs.
+//
+// The list of observers is never changed in place.  Instead, adding or
+// removing an observer builds a new list (leaving out any observers that
+// no longer exist) and swaps it in atomically, so notifying the observers
+// can safely happen on one thread while observers are added or removed on
+// another.  Observers that are notified while the list is being replaced
+// see either the old list or the new one.
+//
+// Getting hold of the list isn't free, though: loading a shared_ptr
+// atomically generally takes one of a pool of locks shared by the whole
+// program, and each observer's weak_ptr has to be locked in turn.  Code
+// that notifies the observers many times in a row should call
+// lockObservers() once and notify the observers it returns.
+//
+// Copying an Observable copies its list of observers; the copies share
+// the list until either one changes it.
 
 #ifndef OBSERVABLE_HPP
 #define OBSERVABLE_HPP
@@ -14,6 +30,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 
@@ -27,16 +44,61 @@ namespace ics46 { namespace observable
         typedef std::function<void(std::shared_ptr<ObserverType>)> NotifyFunction;
 
     public:
+        Observable();
+        Observable(const Observable& other);
+        Observable& operator=(const Observable& other);
+
         void addObserver(std::weak_ptr<ObserverType> observerToAdd);
         void removeObserver(std::weak_ptr<ObserverType> observerToRemove);
         void notifyObservers(NotifyFunction notifyFunction);
 
+        // lockObservers() returns the observers that still exist, each
+        // kept alive for as long as the returned vector holds it.
+        std::vector<std::shared_ptr<ObserverType>> lockObservers() const;
+
+    private:
+        typedef std::vector<std::weak_ptr<ObserverType>> ObserverList;
+
+        std::shared_ptr<const ObserverList> observers;
+
+        // Serializes changes to the list, so that two threads adding
+        // observers at the same time don't lose one of them.  It isn't
+        // copied along with the list.
+        std::mutex changeMutex;
+
     private:
-        std::vector<std::weak_ptr<ObserverType>> observers;
+        template <typename Change>
+        void changeObservers(Change change);
     };
 
 
 
+    template <typename ObserverType>
+    Observable<ObserverType>::Observable()
+        : observers{std::make_shared<const ObserverList>()}
+    {
+    }
+
+
+    template <typename ObserverType>
+    Observable<ObserverType>::Observable(const Observable& other)
+        : observers{std::atomic_load(&other.observers)}
+    {
+    }
+
+
+    template <typename ObserverType>
+    Observable<ObserverType>& Observable<ObserverType>::operator=(const Observable& other)
+    {
+        std::shared_ptr<const ObserverList> otherObservers = std::atomic_load(&other.observers);
+
+        std::lock_guard<std::mutex> lock{changeMutex};
+        std::atomic_store(&observers, otherObservers);
+
+        return *this;
+    }
+
+
     template <typename ObserverType>
     void Observable<ObserverType>::addObserver(std::weak_ptr<ObserverType> observerToAdd)
     {
@@ -45,15 +107,19 @@ namespace ics46 { namespace observable
             return;
         }
 
-        if (!std::any_of(
-                observers.begin(), observers.end(),
-                [=](std::weak_ptr<ObserverType> observer)
+        changeObservers(
+            [&](ObserverList& newObservers)
+            {
+                if (!std::any_of(
+                        newObservers.begin(), newObservers.end(),
+                        [&](const std::weak_ptr<ObserverType>& observer)
+                        {
+                            return observer.lock() == observerToAdd.lock();
+                        }))
                 {
-                    return observer.lock() == observerToAdd.lock();
-                }))
-        {
-            observers.push_back(observerToAdd);
-        }
+                    newObservers.push_back(observerToAdd);
+                }
+            });
     }
 
 
@@ -65,42 +131,78 @@ namespace ics46 { namespace observable
             return;
         }
 
-        observers.erase(
-            std::remove_if(
-                observers.begin(), observers.end(),
-                [=](std::weak_ptr<ObserverType> observer)
-                {
-                    return observer.lock() == observerToRemove.lock();
-                }),
-            observers.end());
+        changeObservers(
+            [&](ObserverList& newObservers)
+            {
+                newObservers.erase(
+                    std::remove_if(
+                        newObservers.begin(), newObservers.end(),
+                        [&](const std::weak_ptr<ObserverType>& observer)
+                        {
+                            return observer.lock() == observerToRemove.lock();
+                        }),
+                    newObservers.end());
+            });
     }
 
 
     template <typename ObserverType>
     void Observable<ObserverType>::notifyObservers(NotifyFunction notifyFunction)
     {
-        observers.erase(
-            std::remove_if(
-                observers.begin(), observers.end(),
-                [=](std::weak_ptr<ObserverType> observer)
-                {
-                    return observer.expired();
-                }),
-            observers.end());
+        std::shared_ptr<const ObserverList> current = std::atomic_load(&observers);
 
-        std::for_each(
-            observers.begin(), observers.end(),
-            [=](std::weak_ptr<ObserverType> observer)
+        for (const std::weak_ptr<ObserverType>& observer : *current)
+        {
+            if (std::shared_ptr<ObserverType> locked = observer.lock())
             {
-                if (!observer.expired())
-                {
-                    notifyFunction(observer.lock());
-                }
-            });
+                notifyFunction(locked);
+            }
+        }
+    }
+
+
+    template <typename ObserverType>
+    std::vector<std::shared_ptr<ObserverType>> Observable<ObserverType>::lockObservers() const
+    {
+        std::shared_ptr<const ObserverList> current = std::atomic_load(&observers);
+        std::vector<std::shared_ptr<ObserverType>> locked;
+        locked.reserve(current->size());
+
+        for (const std::weak_ptr<ObserverType>& observer : *current)
+        {
+            if (std::shared_ptr<ObserverType> lockedObserver = observer.lock())
+            {
+                locked.push_back(std::move(lockedObserver));
+            }
+        }
+
+        return locked;
+    }
+
+
+    template <typename ObserverType>
+    template <typename Change>
+    void Observable<ObserverType>::changeObservers(Change change)
+    {
+        std::lock_guard<std::mutex> lock{changeMutex};
+
+        std::shared_ptr<const ObserverList> current = std::atomic_load(&observers);
+        std::shared_ptr<ObserverList> newObservers = std::make_shared<ObserverList>();
+
+        for (const std::weak_ptr<ObserverType>& observer : *current)
+        {
+            if (!observer.expired())
+            {
+                newObservers->push_back(observer);
+            }
+        }
+
+        change(*newObservers);
+
+        std::atomic_store(&observers, std::shared_ptr<const ObserverList>{newObservers});
     }
 } }
 
 
 
 #endif // OBSERVABLE_HPP
-
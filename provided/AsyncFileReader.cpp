@@ -0,0 +1,464 @@
+// AsyncFileReader.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "AsyncFileReader.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define ASYNCFILEREADER_IO_URING 1
+#endif
+#endif
+
+
+
+#ifdef ASYNCFILEREADER_IO_URING
+
+// A Ring holds an io_uring instance: its file descriptor, and the
+// submission queue, completion queue, and submission queue entries that
+// are shared with the kernel by mapping them into memory.  Destroying it
+// closes the file descriptor, at which point the kernel cancels any reads
+// that are still outstanding.
+struct AsyncFileReader::Ring
+{
+    int fd = -1;
+
+    void* sqRing = MAP_FAILED;
+    std::size_t sqRingSize = 0;
+    void* cqRing = MAP_FAILED;
+    std::size_t cqRingSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    std::size_t sqesSize = 0;
+
+    unsigned int* sqTail = nullptr;
+    unsigned int* sqMask = nullptr;
+    unsigned int* sqArray = nullptr;
+
+    unsigned int* cqHead = nullptr;
+    unsigned int* cqTail = nullptr;
+    unsigned int* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    ~Ring();
+
+    bool setUp(unsigned int entries, char* buffers, std::size_t bufferSize);
+    bool submitRead(
+        int fileDescriptor, unsigned int slot, char* buffer,
+        std::size_t length, std::uint64_t offset);
+    bool waitForCompletion();
+
+    template <typename Function>
+    void forEachCompletion(Function f);
+};
+
+
+
+namespace
+{
+    char* offsetBy(void* base, unsigned int offset)
+    {
+        return static_cast<char*>(base) + offset;
+    }
+}
+
+
+
+AsyncFileReader::Ring::~Ring()
+{
+    if (sqes != MAP_FAILED)
+    {
+        munmap(sqes, sqesSize);
+    }
+
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+    {
+        munmap(cqRing, cqRingSize);
+    }
+
+    if (sqRing != MAP_FAILED)
+    {
+        munmap(sqRing, sqRingSize);
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+
+bool AsyncFileReader::Ring::setUp(unsigned int entries, char* buffers, std::size_t bufferSize)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    fd = syscall(__NR_io_uring_setup, entries, &params);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        sqRingSize = std::max(sqRingSize, cqRingSize);
+        cqRingSize = sqRingSize;
+    }
+
+    sqRing = mmap(
+        nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        fd, IORING_OFF_SQ_RING);
+
+    if (sqRing == MAP_FAILED)
+    {
+        return false;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        cqRing = sqRing;
+    }
+    else
+    {
+        cqRing = mmap(
+            nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            fd, IORING_OFF_CQ_RING);
+
+        if (cqRing == MAP_FAILED)
+        {
+            return false;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe*>(mmap(
+        nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        fd, IORING_OFF_SQES));
+
+    if (sqes == MAP_FAILED)
+    {
+        return false;
+    }
+
+    sqTail = reinterpret_cast<unsigned int*>(offsetBy(sqRing, params.sq_off.tail));
+    sqMask = reinterpret_cast<unsigned int*>(offsetBy(sqRing, params.sq_off.ring_mask));
+    sqArray = reinterpret_cast<unsigned int*>(offsetBy(sqRing, params.sq_off.array));
+
+    cqHead = reinterpret_cast<unsigned int*>(offsetBy(cqRing, params.cq_off.head));
+    cqTail = reinterpret_cast<unsigned int*>(offsetBy(cqRing, params.cq_off.tail));
+    cqMask = reinterpret_cast<unsigned int*>(offsetBy(cqRing, params.cq_off.ring_mask));
+    cqes = reinterpret_cast<io_uring_cqe*>(offsetBy(cqRing, params.cq_off.cqes));
+
+    // The buffers are registered with the kernel once, so that it doesn't
+    // have to map them for every read.
+    std::vector<iovec> iovecs(entries);
+
+    for (unsigned int i = 0; i < entries; ++i)
+    {
+        iovecs[i].iov_base = buffers + i * bufferSize;
+        iovecs[i].iov_len = bufferSize;
+    }
+
+    return syscall(
+        __NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iovecs.data(), entries) == 0;
+}
+
+
+bool AsyncFileReader::Ring::submitRead(
+    int fileDescriptor, unsigned int slot, char* buffer,
+    std::size_t length, std::uint64_t offset)
+{
+    unsigned int tail = __atomic_load_n(sqTail, __ATOMIC_ACQUIRE);
+    unsigned int index = tail & *sqMask;
+
+    io_uring_sqe& sqe = sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READ_FIXED;
+    sqe.fd = fileDescriptor;
+    sqe.addr = reinterpret_cast<std::uint64_t>(buffer);
+    sqe.len = length;
+    sqe.off = offset;
+    sqe.buf_index = slot;
+    sqe.user_data = slot;
+
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    long submitted;
+
+    do
+    {
+        submitted = syscall(__NR_io_uring_enter, fd, 1, 0, 0, nullptr, 0);
+    }
+    while (submitted < 0 && errno == EINTR);
+
+    // If the entry wasn't submitted (because, say, the kernel was short of
+    // memory), it's taken back out of the queue, so that it isn't submitted
+    // along with some later one.
+    if (submitted < 1)
+    {
+        __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool AsyncFileReader::Ring::waitForCompletion()
+{
+    long result;
+
+    do
+    {
+        result = syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    }
+    while (result < 0 && errno == EINTR);
+
+    return result >= 0;
+}
+
+
+template <typename Function>
+void AsyncFileReader::Ring::forEachCompletion(Function f)
+{
+    unsigned int head = *cqHead;
+    unsigned int tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; ++head)
+    {
+        const io_uring_cqe& cqe = cqes[head & *cqMask];
+        f(static_cast<unsigned int>(cqe.user_data), cqe.res);
+    }
+
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+}
+
+#else
+
+struct AsyncFileReader::Ring
+{
+};
+
+#endif // ASYNCFILEREADER_IO_URING
+
+
+
+AsyncFileReader::AsyncFileReader(
+    const std::string& filePath, std::size_t chunkSize, unsigned int queueDepth)
+    : fileDescriptor{::open(filePath.c_str(), O_RDONLY)}, fileSize{0},
+      chunkSize{chunkSize > 0 ? chunkSize : 1},
+      nextOffsetToRead{0}, nextOffsetToReturn{0}, returnedSlot{-1}
+{
+    struct stat status;
+
+    if (fileDescriptor >= 0 && fstat(fileDescriptor, &status) == 0)
+    {
+        fileSize = status.st_size;
+    }
+
+    if (queueDepth == 0)
+    {
+        queueDepth = 1;
+    }
+
+    buffers.reset(new char[this->chunkSize * queueDepth]);
+    slots.resize(queueDepth, Slot{0, 0, 0, false});
+
+#ifdef ASYNCFILEREADER_IO_URING
+    if (fileSize > 0)
+    {
+        ring = std::make_unique<Ring>();
+
+        if (!ring->setUp(queueDepth, buffers.get(), this->chunkSize))
+        {
+            ring.reset();
+        }
+    }
+#endif
+
+    if (ring)
+    {
+        for (unsigned int slot = 0; slot < slots.size(); ++slot)
+        {
+            startRead(slot);
+        }
+    }
+}
+
+
+AsyncFileReader::~AsyncFileReader()
+{
+#ifdef ASYNCFILEREADER_IO_URING
+    // The kernel may still be writing into the buffers, so they can't be
+    // released until every read has finished.
+    if (ring)
+    {
+        for (unsigned int slot = 0; slot < slots.size(); ++slot)
+        {
+            finishRead(slot);
+        }
+    }
+#endif
+
+    ring.reset();
+
+    if (fileDescriptor >= 0)
+    {
+        ::close(fileDescriptor);
+    }
+}
+
+
+bool AsyncFileReader::isOpen() const
+{
+    return fileDescriptor >= 0;
+}
+
+
+bool AsyncFileReader::usesIoUring() const
+{
+    return ring != nullptr;
+}
+
+
+bool AsyncFileReader::nextChunk(std::string_view& chunk)
+{
+    // The buffer handed out by the previous call is free again, so it can
+    // start reading the next chunk that isn't yet being read.
+    if (returnedSlot >= 0)
+    {
+        if (ring)
+        {
+            startRead(returnedSlot);
+        }
+
+        returnedSlot = -1;
+    }
+
+    if (nextOffsetToReturn >= fileSize)
+    {
+        return false;
+    }
+
+    unsigned int slot = (nextOffsetToReturn / chunkSize) % slots.size();
+
+    if (ring)
+    {
+        finishRead(slot);
+    }
+    else
+    {
+        slots[slot] = Slot{
+            nextOffsetToReturn,
+            std::min<std::uint64_t>(chunkSize, fileSize - nextOffsetToReturn),
+            0, false};
+    }
+
+    readRemainder(slot);
+
+    chunk = std::string_view{bufferOf(slot), static_cast<std::size_t>(slots[slot].result)};
+    nextOffsetToReturn += slots[slot].length;
+    returnedSlot = slot;
+
+    return true;
+}
+
+
+char* AsyncFileReader::bufferOf(unsigned int slot)
+{
+    return buffers.get() + slot * chunkSize;
+}
+
+
+void AsyncFileReader::startRead(unsigned int slot)
+{
+#ifdef ASYNCFILEREADER_IO_URING
+    if (nextOffsetToRead >= fileSize)
+    {
+        return;
+    }
+
+    std::size_t length = std::min<std::uint64_t>(chunkSize, fileSize - nextOffsetToRead);
+    slots[slot] = Slot{nextOffsetToRead, length, 0, false};
+
+    // A read that can't be submitted is left for readRemainder() to do
+    // with pread() when its chunk is needed.
+    slots[slot].inFlight =
+        ring->submitRead(fileDescriptor, slot, bufferOf(slot), length, nextOffsetToRead);
+
+    nextOffsetToRead += length;
+#endif
+}
+
+
+void AsyncFileReader::finishRead(unsigned int slot)
+{
+#ifdef ASYNCFILEREADER_IO_URING
+    while (ring && slots[slot].inFlight)
+    {
+        if (!ring->waitForCompletion())
+        {
+            // If waiting fails, the kernel may still be writing into the
+            // buffers of the reads that haven't completed, so the ring is
+            // torn down first, which cancels them and waits for them to
+            // drain.  Only then are the buffers reused, with every chunk
+            // from here on read with pread().
+            ring.reset();
+
+            for (Slot& s : slots)
+            {
+                s.inFlight = false;
+            }
+
+            break;
+        }
+
+        ring->forEachCompletion(
+            [&](unsigned int completed, int result)
+            {
+                slots[completed].result = result > 0 ? result : 0;
+                slots[completed].inFlight = false;
+            });
+    }
+#endif
+}
+
+
+void AsyncFileReader::readRemainder(unsigned int slot)
+{
+    // A read can come up short (or fail, or not be done asynchronously at
+    // all), in which case the rest of the chunk is read here.
+    Slot& s = slots[slot];
+
+    while (s.result < static_cast<long>(s.length))
+    {
+        ssize_t bytesRead = pread(
+            fileDescriptor, bufferOf(slot) + s.result, s.length - s.result, s.offset + s.result);
+
+        if (bytesRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (bytesRead <= 0)
+        {
+            break;
+        }
+
+        s.result += bytesRead;
+    }
+}
@@ -0,0 +1,95 @@
+// AsyncFileReader.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// An AsyncFileReader reads a file from beginning to end in large chunks,
+// keeping several reads in flight at once, so that the disk can be busy
+// reading the next parts of the file while the program works on the part
+// it has.  On Linux, the reads are submitted through io_uring, into
+// buffers registered with the kernel ahead of time; when io_uring isn't
+// available (or the platform isn't Linux), each chunk is instead read
+// with pread() when it's needed.
+//
+// io_uring is used through its system calls directly, so no additional
+// library is needed.
+
+#ifndef ASYNCFILEREADER_HPP
+#define ASYNCFILEREADER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class AsyncFileReader
+{
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+    static constexpr unsigned int DEFAULT_QUEUE_DEPTH = 4;
+
+public:
+    AsyncFileReader(
+        const std::string& filePath,
+        std::size_t chunkSize = DEFAULT_CHUNK_SIZE,
+        unsigned int queueDepth = DEFAULT_QUEUE_DEPTH);
+
+    ~AsyncFileReader();
+
+    AsyncFileReader(const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+    // isOpen() returns true if the file could be opened; a file that
+    // can't be opened is read as though it's empty.
+    bool isOpen() const;
+
+    // usesIoUring() returns true if reads are being submitted through
+    // io_uring, or false if they're done with pread().
+    bool usesIoUring() const;
+
+    // nextChunk() sets chunk to the next part of the file and returns
+    // true, or returns false if the whole file has been read.  The view
+    // is valid only until the next call, at which point its buffer is
+    // used for another read.
+    bool nextChunk(std::string_view& chunk);
+
+private:
+    struct Ring;
+
+    struct Slot
+    {
+        std::uint64_t offset;
+        std::size_t length;
+        long result;
+        bool inFlight;
+    };
+
+    int fileDescriptor;
+    std::uint64_t fileSize;
+    std::size_t chunkSize;
+
+    // The chunk at offset k * chunkSize is read into slot k % slots.size();
+    // each slot's buffer is chunkSize bytes, all in one allocation.
+    std::unique_ptr<char[]> buffers;
+    std::vector<Slot> slots;
+
+    std::unique_ptr<Ring> ring;
+
+    std::uint64_t nextOffsetToRead;
+    std::uint64_t nextOffsetToReturn;
+    int returnedSlot;
+
+private:
+    char* bufferOf(unsigned int slot);
+    void startRead(unsigned int slot);
+    void finishRead(unsigned int slot);
+    void readRemainder(unsigned int slot);
+};
+
+
+
+#endif // ASYNCFILEREADER_HPP
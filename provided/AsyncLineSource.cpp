@@ -0,0 +1,68 @@
+// AsyncLineSource.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "AsyncLineSource.hpp"
+
+
+
+AsyncLineSource::AsyncLineSource(const std::string& filePath, std::size_t chunkSize)
+    : reader{filePath, chunkSize}, chunk{}, carried{}, carriedReturned{false}
+{
+}
+
+
+bool AsyncLineSource::isOpen() const
+{
+    return reader.isOpen();
+}
+
+
+bool AsyncLineSource::nextLine(std::string_view& line)
+{
+    if (carriedReturned)
+    {
+        carried.clear();
+        carriedReturned = false;
+    }
+
+    while (true)
+    {
+        std::size_t newline = chunk.find('\n');
+
+        if (newline != std::string_view::npos)
+        {
+            if (carried.empty())
+            {
+                line = chunk.substr(0, newline);
+            }
+            else
+            {
+                carried.append(chunk.data(), newline);
+                line = carried;
+                carriedReturned = true;
+            }
+
+            chunk = chunk.substr(newline + 1);
+            return true;
+        }
+
+        // The rest of the chunk is the beginning of a line that continues
+        // into the next chunk, so it's copied before its buffer is reused.
+        carried.append(chunk.data(), chunk.length());
+        chunk = std::string_view{};
+
+        if (!reader.nextChunk(chunk))
+        {
+            if (carried.empty())
+            {
+                return false;
+            }
+
+            line = carried;
+            carriedReturned = true;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+// AsyncLineSource.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LineSource that produces the lines of a file read by an
+// AsyncFileReader, so the file is read ahead in the background while its
+// lines are being checked.  Lines that lie within a chunk are handed out
+// as views into the chunk's buffer; only a line that's cut off by the end
+// of a chunk is copied, so that it can be completed from the next one.
+
+#ifndef ASYNCLINESOURCE_HPP
+#define ASYNCLINESOURCE_HPP
+
+#include <string>
+#include <string_view>
+#include "AsyncFileReader.hpp"
+#include "LineSource.hpp"
+
+
+
+class AsyncLineSource : public LineSource
+{
+public:
+    AsyncLineSource(
+        const std::string& filePath,
+        std::size_t chunkSize = AsyncFileReader::DEFAULT_CHUNK_SIZE);
+
+    // isOpen() returns true if the file could be opened.
+    bool isOpen() const;
+
+    // The line is valid only until the next call to nextLine().
+    virtual bool nextLine(std::string_view& line);
+
+private:
+    AsyncFileReader reader;
+
+    // The part of the current chunk that follows the most recent line.
+    std::string_view chunk;
+
+    // The beginning of a line that was cut off by the end of a chunk, and
+    // whether it was handed out by the previous call.
+    std::string carried;
+    bool carriedReturned;
+};
+
+
+
+#endif // ASYNCLINESOURCE_HPP
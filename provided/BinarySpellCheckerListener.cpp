@@ -0,0 +1,78 @@
+// BinarySpellCheckerListener.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include "BinarySpellCheckerListener.hpp"
+
+
+
+namespace
+{
+    void appendInteger(std::string& buffer, std::uint64_t value, unsigned int byteCount)
+    {
+        for (unsigned int i = 0; i < byteCount; ++i)
+        {
+            buffer += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+
+    // Strings longer than a u16 can describe are cut short; words never
+    // come anywhere near that long.
+    void appendString(std::string& buffer, std::string_view text)
+    {
+        std::size_t length = std::min<std::size_t>(
+            text.length(), std::numeric_limits<std::uint16_t>::max());
+
+        appendInteger(buffer, length, 2);
+        buffer.append(text.data(), length);
+    }
+}
+
+
+
+constexpr char BinarySpellCheckerListener::MAGIC[];
+
+
+BinarySpellCheckerListener::BinarySpellCheckerListener(std::ostream& out)
+    : BufferedSpellCheckerListener{out}
+{
+    outputBuffer().append(MAGIC, sizeof(MAGIC) - 1);
+}
+
+
+void BinarySpellCheckerListener::format(
+    std::string& buffer,
+    const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+{
+    // The record's length isn't known until the rest of it is formatted,
+    // so room is left for it, then filled in afterward.
+    std::size_t start = buffer.length();
+    appendInteger(buffer, 0, 4);
+
+    appendInteger(buffer, misspelling.lineNumber, 8);
+    appendInteger(buffer, misspelling.lineOffset, 8);
+    appendInteger(buffer, misspelling.column, 4);
+    appendString(buffer, misspelling.word);
+
+    std::size_t suggestionCount = std::min<std::size_t>(
+        suggestions.size(), std::numeric_limits<std::uint16_t>::max());
+
+    appendInteger(buffer, suggestionCount, 2);
+
+    for (std::size_t i = 0; i < suggestionCount; ++i)
+    {
+        appendString(buffer, suggestions[i]);
+    }
+
+    std::uint64_t length = buffer.length() - start - 4;
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        buffer[start + i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+    }
+}
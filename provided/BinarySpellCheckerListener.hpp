@@ -0,0 +1,50 @@
+// BinarySpellCheckerListener.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckerListener that describes misspellings in a compact binary
+// format, for programs that would rather not parse text at all.  The
+// output begins with the four bytes "WCB1", followed by one record per
+// misspelling.  All integers are unsigned and little-endian, and each
+// record is laid out like this:
+//
+//     u32  the length of the rest of the record, in bytes
+//     u64  the number of the line the word is on, counting from 1
+//     u64  the byte offset of the line within the text
+//     u32  the byte offset of the word within the line
+//     u16  the length of the word, followed by the word (uppercased)
+//     u16  the number of suggestions, followed by each suggestion as a
+//          u16 length and then its bytes
+//
+// Since every record begins with its length, readers can skip records
+// (or fields added to the end of records in later versions) without
+// understanding them.
+//
+// The output is buffered (see BufferedSpellCheckerListener.hpp), and is
+// formatted directly into the buffer, without allocating anything.
+
+#ifndef BINARYSPELLCHECKERLISTENER_HPP
+#define BINARYSPELLCHECKERLISTENER_HPP
+
+#include "BufferedSpellCheckerListener.hpp"
+
+
+
+class BinarySpellCheckerListener : public BufferedSpellCheckerListener
+{
+public:
+    static constexpr char MAGIC[] = "WCB1";
+
+public:
+    BinarySpellCheckerListener(std::ostream& out);
+
+protected:
+    virtual void format(
+        std::string& buffer,
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions);
+};
+
+
+
+#endif // BINARYSPELLCHECKERLISTENER_HPP
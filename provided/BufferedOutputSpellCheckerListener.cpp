@@ -0,0 +1,36 @@
+// BufferedOutputSpellCheckerListener.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "BufferedOutputSpellCheckerListener.hpp"
+
+
+BufferedOutputSpellCheckerListener::BufferedOutputSpellCheckerListener(std::ostream& out)
+    : BufferedSpellCheckerListener{out}
+{
+}
+
+
+void BufferedOutputSpellCheckerListener::format(
+    std::string& buffer,
+    const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+{
+    buffer += '\n';
+    buffer.append(misspelling.line);
+    buffer += "\n     word not found: ";
+    buffer.append(misspelling.word);
+    buffer += '\n';
+
+    if (suggestions.size() > 0)
+    {
+        buffer += "  perhaps you meant:\n";
+
+        for (const std::string& suggestion : suggestions)
+        {
+            buffer += "      ";
+            buffer += suggestion;
+            buffer += '\n';
+        }
+    }
+}
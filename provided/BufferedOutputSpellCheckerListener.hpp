@@ -0,0 +1,32 @@
+// BufferedOutputSpellCheckerListener.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckerListener that prints the same output as an
+// OutputSpellCheckerListener (see OutputSpellCheckerListener.hpp), but
+// buffers it (see BufferedSpellCheckerListener.hpp).  This is much faster
+// when the output isn't going to a terminal, since the stream is written
+// once per buffer rather than once per line.
+
+#ifndef BUFFEREDOUTPUTSPELLCHECKERLISTENER_HPP
+#define BUFFEREDOUTPUTSPELLCHECKERLISTENER_HPP
+
+#include "BufferedSpellCheckerListener.hpp"
+
+
+
+class BufferedOutputSpellCheckerListener : public BufferedSpellCheckerListener
+{
+public:
+    BufferedOutputSpellCheckerListener(std::ostream& out);
+
+protected:
+    virtual void format(
+        std::string& buffer,
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions);
+};
+
+
+
+#endif // BUFFEREDOUTPUTSPELLCHECKERLISTENER_HPP
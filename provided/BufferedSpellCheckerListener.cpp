@@ -0,0 +1,84 @@
+// BufferedSpellCheckerListener.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "BufferedSpellCheckerListener.hpp"
+
+
+constexpr std::size_t BufferedSpellCheckerListener::FLUSH_SIZE;
+constexpr std::chrono::milliseconds BufferedSpellCheckerListener::FLUSH_INTERVAL;
+
+
+BufferedSpellCheckerListener::BufferedSpellCheckerListener(std::ostream& out)
+    : out{out}, lastFlush{std::chrono::steady_clock::now()}
+{
+    // Leave room for one more misspelling past the flush size, so that
+    // the buffer rarely needs to grow.
+    buffer.reserve(FLUSH_SIZE + 4096);
+}
+
+
+BufferedSpellCheckerListener::~BufferedSpellCheckerListener()
+{
+    flush();
+}
+
+
+void BufferedSpellCheckerListener::misspellingFound(
+    const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+{
+    format(buffer, misspelling, suggestions);
+    flushIfDue();
+}
+
+
+void BufferedSpellCheckerListener::misspellingsFound(const MisspellingBatch& batch)
+{
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        format(buffer, batch.misspelling(i), batch.suggestions(i));
+
+        if (buffer.size() >= FLUSH_SIZE)
+        {
+            flush();
+        }
+    }
+
+    flushIfDue();
+}
+
+
+void BufferedSpellCheckerListener::checkingFinished()
+{
+    flush();
+}
+
+
+void BufferedSpellCheckerListener::flush()
+{
+    if (!buffer.empty())
+    {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    out.flush();
+    lastFlush = std::chrono::steady_clock::now();
+}
+
+
+std::string& BufferedSpellCheckerListener::outputBuffer()
+{
+    return buffer;
+}
+
+
+void BufferedSpellCheckerListener::flushIfDue()
+{
+    if (buffer.size() >= FLUSH_SIZE
+        || std::chrono::steady_clock::now() - lastFlush >= FLUSH_INTERVAL)
+    {
+        flush();
+    }
+}
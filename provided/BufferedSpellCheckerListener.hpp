@@ -0,0 +1,77 @@
+// BufferedSpellCheckerListener.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// An abstract base class for SpellCheckerListeners that describe each
+// misspelling by formatting it into a buffer that's reused from one write
+// to the next.  The buffer is written out only when it's grown large,
+// when it's been a while since it was last written, or when the spell
+// checker is finished, so the stream is written (and flushed) once per
+// buffer rather than once per misspelling.  Derived classes decide how
+// misspellings are formatted.
+//
+// How long it's been since the buffer was written is only checked when
+// a misspelling is found, so a long stretch of correctly spelled text can
+// delay output for longer than the flush interval.
+
+#ifndef BUFFEREDSPELLCHECKERLISTENER_HPP
+#define BUFFEREDSPELLCHECKERLISTENER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "SpellCheckerListener.hpp"
+
+
+
+class BufferedSpellCheckerListener : public SpellCheckerListener
+{
+public:
+    // The size the buffer can reach before it's written out, and the time
+    // that can pass after one write before the buffer is written again.
+    static constexpr std::size_t FLUSH_SIZE = 64 * 1024;
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{250};
+
+public:
+    BufferedSpellCheckerListener(std::ostream& out);
+
+    // Anything still in the buffer is written out when the listener is
+    // destroyed.
+    virtual ~BufferedSpellCheckerListener();
+
+    virtual void misspellingFound(
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions);
+
+    virtual void misspellingsFound(const MisspellingBatch& batch);
+
+    virtual void checkingFinished();
+
+    // flush() writes out whatever is in the buffer, then flushes the
+    // stream.
+    void flush();
+
+protected:
+    // format() appends a description of the misspelling to the buffer.
+    virtual void format(
+        std::string& buffer,
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions) = 0;
+
+    // outputBuffer() returns the buffer, so that derived classes can add
+    // output other than misspellings (such as a header) to it.
+    std::string& outputBuffer();
+
+private:
+    std::ostream& out;
+    std::string buffer;
+    std::chrono::steady_clock::time_point lastFlush;
+
+private:
+    void flushIfDue();
+};
+
+
+
+#endif // BUFFEREDSPELLCHECKERLISTENER_HPP
@@ -0,0 +1,38 @@
+// CopyingSpellCheckerListener.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A base class for listeners that are told about misspellings the way
+// they originally were: given their own copies of the misspelled word and
+// the line it's on, rather than a Misspelling that refers to the text in
+// place.  It copies them from each Misspelling and passes them along.
+
+#ifndef COPYINGSPELLCHECKERLISTENER_HPP
+#define COPYINGSPELLCHECKERLISTENER_HPP
+
+#include <string>
+#include <vector>
+#include "SpellCheckerListener.hpp"
+
+
+
+class CopyingSpellCheckerListener : public SpellCheckerListener
+{
+public:
+    virtual void misspellingFound(
+        const std::string& word, const std::string& line,
+        const std::vector<std::string>& suggestions) = 0;
+
+
+    virtual void misspellingFound(
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+    {
+        misspellingFound(
+            std::string{misspelling.word}, std::string{misspelling.line}, suggestions);
+    }
+};
+
+
+
+#endif // COPYINGSPELLCHECKERLISTENER_HPP
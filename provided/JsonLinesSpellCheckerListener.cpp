@@ -0,0 +1,95 @@
+// JsonLinesSpellCheckerListener.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <charconv>
+#include "JsonLinesSpellCheckerListener.hpp"
+
+
+
+namespace
+{
+    void appendNumber(std::string& buffer, unsigned long long number)
+    {
+        char digits[20];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+        buffer.append(digits, result.ptr);
+    }
+
+
+    // appendString() appends the text as a JSON string.  Words rarely
+    // contain anything that needs escaping, so the text is appended in
+    // runs between the characters that do.
+    void appendString(std::string& buffer, std::string_view text)
+    {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+
+        buffer += '"';
+
+        std::size_t runStart = 0;
+
+        for (std::size_t i = 0; i < text.length(); ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+
+            if (c != '"' && c != '\\' && c >= 0x20)
+            {
+                continue;
+            }
+
+            buffer.append(text.data() + runStart, i - runStart);
+            runStart = i + 1;
+
+            if (c == '"' || c == '\\')
+            {
+                buffer += '\\';
+                buffer += static_cast<char>(c);
+            }
+            else
+            {
+                buffer += "\\u00";
+                buffer += HEX_DIGITS[c >> 4];
+                buffer += HEX_DIGITS[c & 0xF];
+            }
+        }
+
+        buffer.append(text.data() + runStart, text.length() - runStart);
+        buffer += '"';
+    }
+}
+
+
+
+JsonLinesSpellCheckerListener::JsonLinesSpellCheckerListener(std::ostream& out)
+    : BufferedSpellCheckerListener{out}
+{
+}
+
+
+void JsonLinesSpellCheckerListener::format(
+    std::string& buffer,
+    const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+{
+    buffer += "{\"word\":";
+    appendString(buffer, misspelling.word);
+    buffer += ",\"line\":";
+    appendNumber(buffer, misspelling.lineNumber);
+    buffer += ",\"column\":";
+    appendNumber(buffer, misspelling.column);
+    buffer += ",\"offset\":";
+    appendNumber(buffer, misspelling.lineOffset + misspelling.column);
+    buffer += ",\"suggestions\":[";
+
+    for (std::size_t i = 0; i < suggestions.size(); ++i)
+    {
+        if (i > 0)
+        {
+            buffer += ',';
+        }
+
+        appendString(buffer, suggestions[i]);
+    }
+
+    buffer += "]}\n";
+}
@@ -0,0 +1,41 @@
+// JsonLinesSpellCheckerListener.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckerListener that describes each misspelling as one line of
+// JSON (a format known as "JSON Lines"), for programs to read rather than
+// people, such as:
+//
+//     {"word":"TEH","line":3,"column":5,"offset":18,"suggestions":["THE"]}
+//
+// where "word" is the misspelled word (uppercased), "line" is the number
+// of the line it's on (counting from 1), "column" is the byte offset of
+// the word within that line and "offset" is its byte offset within the
+// text (both counting from 0), and "suggestions" are in the same order
+// they would have been displayed.
+//
+// The output is buffered (see BufferedSpellCheckerListener.hpp), and is
+// formatted directly into the buffer, without allocating anything.
+
+#ifndef JSONLINESSPELLCHECKERLISTENER_HPP
+#define JSONLINESSPELLCHECKERLISTENER_HPP
+
+#include "BufferedSpellCheckerListener.hpp"
+
+
+
+class JsonLinesSpellCheckerListener : public BufferedSpellCheckerListener
+{
+public:
+    JsonLinesSpellCheckerListener(std::ostream& out);
+
+protected:
+    virtual void format(
+        std::string& buffer,
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions);
+};
+
+
+
+#endif // JSONLINESSPELLCHECKERLISTENER_HPP
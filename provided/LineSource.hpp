@@ -0,0 +1,31 @@
+// LineSource.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LineSource is an abstract base class for things that produce the
+// lines of a text, one at a time, for a TextReader to split into words.
+
+#ifndef LINESOURCE_HPP
+#define LINESOURCE_HPP
+
+#include <string_view>
+
+
+
+class LineSource
+{
+public:
+    virtual ~LineSource() = default;
+
+
+    // nextLine() sets line to the next line of text, not including its
+    // newline, and returns true, or returns false if there are no more
+    // lines.  The view is valid until the next call to nextLine(), though
+    // some sources make stronger promises.
+    virtual bool nextLine(std::string_view& line) = 0;
+};
+
+
+
+#endif // LINESOURCE_HPP
@@ -0,0 +1,77 @@
+// MappedFile.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.hpp"
+
+
+
+MappedFile::MappedFile(const std::string& filePath)
+    : opened{false}, mapping{nullptr}, mappingSize{0}
+{
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    opened = true;
+
+    struct stat status;
+
+    if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+    {
+        void* address = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (address != MAP_FAILED)
+        {
+            madvise(address, status.st_size, MADV_SEQUENTIAL);
+            mapping = address;
+            mappingSize = status.st_size;
+        }
+    }
+
+    close(fd);
+
+    if (mapping == nullptr)
+    {
+        std::ifstream file{filePath, std::ios::binary};
+        buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    }
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mappingSize);
+    }
+}
+
+
+bool MappedFile::isOpen() const
+{
+    return opened;
+}
+
+
+std::string_view MappedFile::contents() const
+{
+    if (mapping != nullptr)
+    {
+        return std::string_view{static_cast<const char*>(mapping), mappingSize};
+    }
+    else
+    {
+        return std::string_view{buffer};
+    }
+}
@@ -0,0 +1,52 @@
+// MappedFile.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A MappedFile makes the contents of a file available in memory by mapping
+// it (read-only) into the process' address space, so that it can be read
+// without copying it into buffers first.  Files that can't be mapped (for
+// example, because they're not regular files) are read into memory
+// instead, so a MappedFile can be used with any file that can be opened.
+//
+// A file that cannot be opened at all is treated as though it is empty,
+// which matches the behavior of an std::ifstream that fails to open.
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+
+class MappedFile
+{
+public:
+    MappedFile(const std::string& filePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // isOpen() returns true if the file could be opened.
+    bool isOpen() const;
+
+    // contents() returns the contents of the file.  The view remains valid
+    // for as long as the MappedFile exists.
+    std::string_view contents() const;
+
+private:
+    bool opened;
+
+    // If the file was mapped, mapping and mappingSize describe the mapping;
+    // otherwise, mapping is nullptr and the contents are held in buffer.
+    void* mapping;
+    std::size_t mappingSize;
+    std::string buffer;
+};
+
+
+
+#endif // MAPPEDFILE_HPP
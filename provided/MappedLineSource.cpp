@@ -0,0 +1,19 @@
+// MappedLineSource.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "MappedLineSource.hpp"
+
+
+
+MappedLineSource::MappedLineSource(const std::string& filePath)
+    : file{filePath}, lines{file.contents()}
+{
+}
+
+
+bool MappedLineSource::nextLine(std::string_view& line)
+{
+    return lines.nextLine(line);
+}
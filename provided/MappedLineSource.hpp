@@ -0,0 +1,35 @@
+// MappedLineSource.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LineSource that produces the lines of a file that's been mapped into
+// memory (see MappedFile.hpp).  The lines it produces are views into the
+// mapping, so they remain valid for as long as the MappedLineSource does.
+
+#ifndef MAPPEDLINESOURCE_HPP
+#define MAPPEDLINESOURCE_HPP
+
+#include <string>
+#include <string_view>
+#include "LineSource.hpp"
+#include "MappedFile.hpp"
+#include "ViewLineSource.hpp"
+
+
+
+class MappedLineSource : public LineSource
+{
+public:
+    MappedLineSource(const std::string& filePath);
+
+    virtual bool nextLine(std::string_view& line);
+
+private:
+    MappedFile file;
+    ViewLineSource lines;
+};
+
+
+
+#endif // MAPPEDLINESOURCE_HPP
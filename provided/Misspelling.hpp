@@ -0,0 +1,52 @@
+// Misspelling.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A Misspelling describes where a misspelled word was found, without
+// copying any of the text: the line it's on is a view into the reader's
+// buffer, and the word's position is given as a line number and offsets,
+// so listeners can slice out whatever text they need.
+//
+// The views are only valid for the duration of the notification that
+// carries the Misspelling; listeners that need to keep any of the text
+// must copy it.
+
+#ifndef MISSPELLING_HPP
+#define MISSPELLING_HPP
+
+#include <cstddef>
+#include <string_view>
+
+
+
+struct Misspelling
+{
+    // The misspelled word, uppercased.
+    std::string_view word;
+
+    // The line containing the word, without its newline.
+    std::string_view line;
+
+    // The number of the line in the text, counting from 1.
+    unsigned long lineNumber;
+
+    // The byte offset of the beginning of the line within the text.
+    std::size_t lineOffset;
+
+    // The byte offset of the word within the line (so the word begins at
+    // byte lineOffset + column of the text), and its length in bytes.
+    std::size_t column;
+    std::size_t length;
+
+
+    // text() returns the word as it appears in the line.
+    std::string_view text() const
+    {
+        return line.substr(column, length);
+    }
+};
+
+
+
+#endif // MISSPELLING_HPP
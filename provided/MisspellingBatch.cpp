@@ -0,0 +1,71 @@
+// MisspellingBatch.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "MisspellingBatch.hpp"
+
+
+
+void MisspellingBatch::add(
+    const Misspelling& misspelling, std::vector<std::string> suggestions)
+{
+    std::size_t lineStart;
+
+    if (!entries.empty()
+        && entries.back().lineNumber == misspelling.lineNumber
+        && entries.back().lineOffset == misspelling.lineOffset)
+    {
+        lineStart = entries.back().lineStart;
+    }
+    else
+    {
+        lineStart = text.length();
+        text.append(misspelling.line);
+    }
+
+    std::size_t wordStart = text.length();
+    text.append(misspelling.word);
+
+    entries.push_back(Entry{
+        wordStart, lineStart, misspelling.line.length(),
+        misspelling.lineNumber, misspelling.lineOffset,
+        misspelling.column, misspelling.length, std::move(suggestions)});
+}
+
+
+void MisspellingBatch::clear()
+{
+    text.clear();
+    entries.clear();
+}
+
+
+std::size_t MisspellingBatch::size() const
+{
+    return entries.size();
+}
+
+
+bool MisspellingBatch::empty() const
+{
+    return entries.empty();
+}
+
+
+Misspelling MisspellingBatch::misspelling(std::size_t index) const
+{
+    const Entry& entry = entries[index];
+    std::string_view view{text};
+
+    return Misspelling{
+        view.substr(entry.wordStart, entry.length),
+        view.substr(entry.lineStart, entry.lineLength),
+        entry.lineNumber, entry.lineOffset, entry.column, entry.length};
+}
+
+
+const std::vector<std::string>& MisspellingBatch::suggestions(std::size_t index) const
+{
+    return entries[index].suggestions;
+}
@@ -0,0 +1,64 @@
+// MisspellingBatch.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A MisspellingBatch holds a number of misspellings, in the order they
+// were found, so that listeners can be notified of all of them at once.
+// Unlike a Misspelling on its own (see Misspelling.hpp), a batch owns
+// copies of the text it describes, so it remains valid after the reader
+// has moved on, and can be handed to another thread.  Consecutive
+// misspellings on the same line share one copy of it.
+
+#ifndef MISSPELLINGBATCH_HPP
+#define MISSPELLINGBATCH_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Misspelling.hpp"
+
+
+
+class MisspellingBatch
+{
+public:
+    // add() copies the misspelling's word and line into the batch, along
+    // with its suggestions.
+    void add(const Misspelling& misspelling, std::vector<std::string> suggestions);
+
+    // clear() empties the batch, keeping the memory it has allocated so
+    // that it can be filled again cheaply.
+    void clear();
+
+    std::size_t size() const;
+    bool empty() const;
+
+    // misspelling() returns the misspelling at the given index.  Its views
+    // are into the batch, so they remain valid until the batch is changed.
+    Misspelling misspelling(std::size_t index) const;
+
+    const std::vector<std::string>& suggestions(std::size_t index) const;
+
+private:
+    // The words and lines are copied into text; entries give their
+    // positions within it, along with the rest of each Misspelling.
+    struct Entry
+    {
+        std::size_t wordStart;
+        std::size_t lineStart;
+        std::size_t lineLength;
+        unsigned long lineNumber;
+        std::size_t lineOffset;
+        std::size_t column;
+        std::size_t length;
+        std::vector<std::string> suggestions;
+    };
+
+    std::string text;
+    std::vector<Entry> entries;
+};
+
+
+
+#endif // MISSPELLINGBATCH_HPP
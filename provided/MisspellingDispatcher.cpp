@@ -0,0 +1,149 @@
+// MisspellingDispatcher.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include "MisspellingDispatcher.hpp"
+
+
+
+MisspellingDispatcher::MisspellingDispatcher(
+    DeliverFunction deliver, std::size_t batchSize, bool useThread)
+    : deliver{std::move(deliver)}, batchSize{std::max<std::size_t>(batchSize, 1)},
+      useThread{useThread}, current{std::make_unique<MisspellingBatch>()},
+      delivering{false}, stopping{false}
+{
+    if (useThread)
+    {
+        thread = std::thread{[this]() { deliverQueued(); }};
+    }
+}
+
+
+MisspellingDispatcher::~MisspellingDispatcher()
+{
+    stop();
+}
+
+
+void MisspellingDispatcher::add(
+    const Misspelling& misspelling, std::vector<std::string> suggestions)
+{
+    current->add(misspelling, std::move(suggestions));
+
+    if (current->size() >= batchSize)
+    {
+        handOff();
+    }
+}
+
+
+void MisspellingDispatcher::finish()
+{
+    if (!current->empty())
+    {
+        handOff();
+    }
+
+    if (useThread)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        changed.wait(lock, [this]() { return (queued.empty() && !delivering) || failure; });
+
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+}
+
+
+void MisspellingDispatcher::handOff()
+{
+    if (!useThread)
+    {
+        deliver(*current);
+        current->clear();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock{mutex};
+    changed.wait(lock, [this]() { return queued.size() < MAX_QUEUED_BATCHES || failure; });
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+
+    queued.push_back(std::move(current));
+
+    if (emptied.empty())
+    {
+        current = std::make_unique<MisspellingBatch>();
+    }
+    else
+    {
+        current = std::move(emptied.back());
+        emptied.pop_back();
+    }
+
+    changed.notify_all();
+}
+
+
+void MisspellingDispatcher::deliverQueued()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+
+    while (true)
+    {
+        changed.wait(lock, [this]() { return !queued.empty() || stopping; });
+
+        if (queued.empty() || failure)
+        {
+            return;
+        }
+
+        std::unique_ptr<MisspellingBatch> batch = std::move(queued.front());
+        queued.pop_front();
+        delivering = true;
+
+        lock.unlock();
+
+        try
+        {
+            deliver(*batch);
+            batch->clear();
+        }
+        catch (...)
+        {
+            lock.lock();
+            failure = std::current_exception();
+            delivering = false;
+            changed.notify_all();
+            return;
+        }
+
+        lock.lock();
+        emptied.push_back(std::move(batch));
+        delivering = false;
+        changed.notify_all();
+    }
+}
+
+
+void MisspellingDispatcher::stop()
+{
+    if (thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+            queued.clear();
+        }
+
+        changed.notify_all();
+        thread.join();
+    }
+}
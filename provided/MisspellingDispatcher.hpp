@@ -0,0 +1,87 @@
+// MisspellingDispatcher.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A MisspellingDispatcher collects misspellings into batches (see
+// MisspellingBatch.hpp) and delivers each batch once it's full, so that
+// whatever it's delivered to is called once per batch rather than once
+// per misspelling.
+//
+// Batches can be delivered either on the thread that adds the
+// misspellings or on a thread of the dispatcher's own.  In the latter
+// case, full batches are queued for that thread, up to a limit beyond
+// which adding a misspelling waits for the queue to drain, and emptied
+// batches are handed back to be refilled rather than reallocated.  If a
+// delivery throws an exception, no more batches are delivered, and the
+// exception is rethrown to the adding thread by the next call to add()
+// or finish().
+
+#ifndef MISSPELLINGDISPATCHER_HPP
+#define MISSPELLINGDISPATCHER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MisspellingBatch.hpp"
+
+
+
+class MisspellingDispatcher
+{
+public:
+    typedef std::function<void(const MisspellingBatch&)> DeliverFunction;
+
+    // The number of full batches that can be waiting for the dispatcher's
+    // thread before adding another misspelling waits.
+    static constexpr std::size_t MAX_QUEUED_BATCHES = 8;
+
+public:
+    MisspellingDispatcher(DeliverFunction deliver, std::size_t batchSize, bool useThread);
+
+    // Destroying a dispatcher that hasn't finished abandons any batches
+    // that haven't been delivered yet.
+    ~MisspellingDispatcher();
+
+    MisspellingDispatcher(const MisspellingDispatcher&) = delete;
+    MisspellingDispatcher& operator=(const MisspellingDispatcher&) = delete;
+
+    void add(const Misspelling& misspelling, std::vector<std::string> suggestions);
+
+    // finish() delivers any misspellings that haven't been, then waits
+    // until every batch has been delivered.
+    void finish();
+
+private:
+    DeliverFunction deliver;
+    std::size_t batchSize;
+    bool useThread;
+
+    std::unique_ptr<MisspellingBatch> current;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::unique_ptr<MisspellingBatch>> queued;
+    std::vector<std::unique_ptr<MisspellingBatch>> emptied;
+    bool delivering;
+    bool stopping;
+    std::exception_ptr failure;
+
+    std::thread thread;
+
+private:
+    void handOff();
+    void deliverQueued();
+    void stop();
+};
+
+
+
+#endif // MISSPELLINGDISPATCHER_HPP
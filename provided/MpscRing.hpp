@@ -0,0 +1,137 @@
+// MpscRing.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// An MpscRing is a bounded, lock-free queue connecting any number of
+// threads that push values to exactly one thread that pops them.  Like
+// an SpscRing (see SpscRing.hpp), its values are kept in a ring of slots
+// whose number is a power of two, but each slot also carries a sequence
+// number that says whether it's ready to be written or read, so pushing
+// threads can claim slots by advancing the tail with a compare-and-swap,
+// then fill them in without getting in each other's way.
+
+#ifndef MPSCRING_HPP
+#define MPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "SpscRing.hpp"
+
+
+
+template <typename T>
+class MpscRing
+{
+public:
+    // The capacity is rounded up to a power of two.
+    explicit MpscRing(std::size_t capacity);
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    std::size_t capacity() const;
+
+    // tryPush() moves the value into the ring and returns true, unless the
+    // ring is full, in which case it returns false and leaves the value
+    // alone.  Any thread may call it.
+    bool tryPush(T& value);
+
+    // tryPop() moves the oldest value out of the ring into value and
+    // returns true, unless the ring is empty (or its oldest slot hasn't
+    // been filled in yet), in which case it returns false.  Only the
+    // consuming thread may call it.
+    bool tryPop(T& value);
+
+private:
+    // A slot whose sequence number equals the position of the push that
+    // will fill it is empty; once the push is done, it's one greater.
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t slotCount;
+    std::size_t mask;
+
+    alignas(64) std::size_t head;
+    alignas(64) std::atomic<std::size_t> tail;
+};
+
+
+
+template <typename T>
+MpscRing<T>::MpscRing(std::size_t capacity)
+    : slotCount{spsc_ring_detail::roundUpToPowerOfTwo(capacity)},
+      mask{slotCount - 1}, head{0}, tail{0}
+{
+    slots.reset(new Slot[slotCount]);
+
+    for (std::size_t i = 0; i < slotCount; ++i)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+template <typename T>
+std::size_t MpscRing<T>::capacity() const
+{
+    return slotCount;
+}
+
+
+template <typename T>
+bool MpscRing<T>::tryPush(T& value)
+{
+    std::size_t t = tail.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Slot& slot = slots[t & mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (sequence == t)
+        {
+            if (tail.compare_exchange_weak(t, t + 1, std::memory_order_relaxed))
+            {
+                slot.value = std::move(value);
+                slot.sequence.store(t + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (sequence < t)
+        {
+            // The slot still holds the value pushed one lap ago.
+            return false;
+        }
+        else
+        {
+            t = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+template <typename T>
+bool MpscRing<T>::tryPop(T& value)
+{
+    Slot& slot = slots[head & mask];
+
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+    {
+        return false;
+    }
+
+    value = std::move(slot.value);
+    slot.sequence.store(head + slotCount, std::memory_order_release);
+    ++head;
+    return true;
+}
+
+
+
+#endif // MPSCRING_HPP
@@ -0,0 +1,353 @@
+// Normalization.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <cstdint>
+#include <cstring>
+#include "Normalization.hpp"
+#include "SimdSupport.hpp"
+
+
+
+namespace
+{
+    typedef void (*UppercaseFunction)(const char* text, std::size_t length, char* out);
+
+
+    void uppercaseScalar(const char* text, std::size_t length, char* out)
+    {
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            out[i] = toUppercase(text[i]);
+        }
+    }
+
+
+#ifdef SIMD_X86
+
+    void uppercaseSSE2(const char* text, std::size_t length, char* out)
+    {
+        const __m128i lowerA = _mm_set1_epi8('a');
+        const __m128i twentyFive = _mm_set1_epi8(25);
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+
+        std::size_t i = 0;
+
+        for (; i + 16 <= length; i += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            __m128i lower = lessOrEqual(_mm_sub_epi8(x, lowerA), twentyFive);
+            __m128i folded = _mm_sub_epi8(x, _mm_and_si128(lower, caseBit));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), folded);
+        }
+
+        uppercaseScalar(text + i, length - i, out + i);
+    }
+
+
+    __attribute__((target("avx2")))
+    void uppercaseAVX2(const char* text, std::size_t length, char* out)
+    {
+        const __m256i lowerA = _mm256_set1_epi8('a');
+        const __m256i twentyFive = _mm256_set1_epi8(25);
+        const __m256i caseBit = _mm256_set1_epi8(0x20);
+
+        std::size_t i = 0;
+
+        for (; i + 32 <= length; i += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+            __m256i lower = lessOrEqual256(_mm256_sub_epi8(x, lowerA), twentyFive);
+            __m256i folded = _mm256_sub_epi8(x, _mm256_and_si256(lower, caseBit));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), folded);
+        }
+
+        uppercaseScalar(text + i, length - i, out + i);
+    }
+
+#endif // SIMD_X86
+
+
+    UppercaseFunction chooseUppercase()
+    {
+#ifdef SIMD_X86
+        return hasAVX2() ? uppercaseAVX2 : uppercaseSSE2;
+#else
+        return uppercaseScalar;
+#endif
+    }
+
+
+    struct CodePointRange
+    {
+        char32_t first;
+        char32_t last;
+    };
+
+
+    // The ranges of non-ASCII code points treated as letters, in order.
+    constexpr CodePointRange LETTER_RANGES[] =
+    {
+        {0x00AA, 0x00AA}, {0x00B5, 0x00B5}, {0x00BA, 0x00BA},
+        {0x00C0, 0x00D6}, {0x00D8, 0x00F6}, {0x00F8, 0x02AF},
+        {0x0370, 0x0373}, {0x0376, 0x0377}, {0x037B, 0x037D}, {0x037F, 0x037F},
+        {0x0386, 0x0386}, {0x0388, 0x03FF},
+        {0x0400, 0x0481}, {0x048A, 0x052F},
+        {0x0531, 0x0556}, {0x0561, 0x0587},
+        {0x05D0, 0x05EA}, {0x0620, 0x064A},
+        {0x1E00, 0x1FBC}, {0x1FC2, 0x1FCC}, {0x1FD0, 0x1FDB}, {0x1FE0, 0x1FEC},
+        {0x1FF2, 0x1FFC},
+        {0x3041, 0x3096}, {0x30A1, 0x30FA}, {0x3400, 0x4DBF}, {0x4E00, 0x9FFF},
+        {0xAC00, 0xD7A3}
+    };
+
+
+    // A CaseRange describes lowercase letters that are made uppercase in
+    // the same way: either by adding a delta to each of them, or, when
+    // alternating is true, because uppercase and lowercase letters
+    // alternate through the range, starting with an uppercase one.  Only
+    // letters whose uppercase versions are encoded with as many bytes as
+    // themselves are included, so uppercasing never moves a word.
+    struct CaseRange
+    {
+        char32_t first;
+        char32_t last;
+        int delta;
+        bool alternating;
+    };
+
+
+    constexpr CaseRange CASE_RANGES[] =
+    {
+        {0x00B5, 0x00B5, 0x039C - 0x00B5, false},
+        {0x00E0, 0x00F6, -0x20, false}, {0x00F8, 0x00FE, -0x20, false},
+        {0x00FF, 0x00FF, 0x0178 - 0x00FF, false},
+        {0x0100, 0x012F, 0, true}, {0x0132, 0x0137, 0, true}, {0x0139, 0x0148, 0, true},
+        {0x014A, 0x0177, 0, true}, {0x0179, 0x017E, 0, true},
+        {0x03AC, 0x03AC, 0x0386 - 0x03AC, false}, {0x03AD, 0x03AF, -0x25, false},
+        {0x03B1, 0x03C1, -0x20, false}, {0x03C2, 0x03C2, 0x03A3 - 0x03C2, false},
+        {0x03C3, 0x03CB, -0x20, false}, {0x03CC, 0x03CC, 0x038C - 0x03CC, false},
+        {0x03CD, 0x03CE, -0x3F, false},
+        {0x0430, 0x044F, -0x20, false}, {0x0450, 0x045F, -0x50, false},
+        {0x0460, 0x0481, 0, true}, {0x048A, 0x04BF, 0, true},
+        {0x0561, 0x0586, -0x30, false},
+        {0x1E00, 0x1E95, 0, true}, {0x1EA0, 0x1EFF, 0, true}
+    };
+
+
+    // encodeUtf8() stores the UTF-8 encoding of the code point into out,
+    // which has room for exactly as many bytes as it needs.
+    void encodeUtf8(char32_t codePoint, char* out, std::size_t length)
+    {
+        if (length == 1)
+        {
+            out[0] = static_cast<char>(codePoint);
+            return;
+        }
+
+        for (std::size_t i = length - 1; i > 0; --i)
+        {
+            out[i] = static_cast<char>(0x80 | (codePoint & 0x3F));
+            codePoint >>= 6;
+        }
+
+        out[0] = static_cast<char>((0xF00 >> length) | codePoint);
+    }
+}
+
+
+
+void uppercaseAscii(const char* text, std::size_t length, char* out)
+{
+    static const UppercaseFunction uppercase = chooseUppercase();
+    uppercase(text, length, out);
+}
+
+
+std::string encodeUtf8(char32_t codePoint)
+{
+    std::size_t length =
+        codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+
+    std::string encoded(length, '\0');
+    encodeUtf8(codePoint, &encoded[0], length);
+    return encoded;
+}
+
+
+std::string normalizeWord(std::string_view line, TextEncoding encoding)
+{
+    std::string word = normalizeWord(line);
+
+    if (encoding == TextEncoding::Utf8)
+    {
+        uppercaseUtf8(word.data(), word.length(), &word[0]);
+    }
+
+    return word;
+}
+
+
+bool decodeUtf8(
+    std::string_view text, std::size_t position, char32_t& codePoint, std::size_t& length)
+{
+    unsigned char lead = text[position];
+    length = 1;
+
+    if (lead < 0x80)
+    {
+        codePoint = lead;
+        return true;
+    }
+    else if (!hasClass(lead, UTF8_LEAD))
+    {
+        return false;
+    }
+
+    std::size_t sequenceLength = lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+
+    if (position + sequenceLength > text.length())
+    {
+        return false;
+    }
+
+    char32_t value = lead & (0x7F >> sequenceLength);
+
+    for (std::size_t i = 1; i < sequenceLength; ++i)
+    {
+        char c = text[position + i];
+
+        if (!hasClass(c, UTF8_CONTINUATION))
+        {
+            return false;
+        }
+
+        value = (value << 6) | (static_cast<unsigned char>(c) & 0x3F);
+    }
+
+    // Overlong forms, surrogates, and values beyond Unicode's range are
+    // not valid.
+    constexpr char32_t minimums[] = {0, 0, 0x80, 0x800, 0x10000};
+
+    if (value < minimums[sequenceLength]
+        || (value >= 0xD800 && value <= 0xDFFF)
+        || value > 0x10FFFF)
+    {
+        return false;
+    }
+
+    codePoint = value;
+    length = sequenceLength;
+    return true;
+}
+
+
+bool isNonAsciiLetter(char32_t codePoint)
+{
+    for (const CodePointRange& range : LETTER_RANGES)
+    {
+        if (codePoint < range.first)
+        {
+            return false;
+        }
+        else if (codePoint <= range.last)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+char32_t uppercaseCodePoint(char32_t codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        return static_cast<unsigned char>(toUppercase(static_cast<char>(codePoint)));
+    }
+
+    for (const CaseRange& range : CASE_RANGES)
+    {
+        if (codePoint < range.first)
+        {
+            return codePoint;
+        }
+        else if (codePoint <= range.last)
+        {
+            if (range.alternating)
+            {
+                return codePoint - (codePoint - range.first) % 2;
+            }
+            else
+            {
+                return codePoint + range.delta;
+            }
+        }
+    }
+
+    return codePoint;
+}
+
+
+void uppercaseUtf8(const char* text, std::size_t length, char* out)
+{
+    std::string_view view{text, length};
+
+    if (!containsNonAscii(view))
+    {
+        uppercaseAscii(text, length, out);
+        return;
+    }
+
+    std::size_t position = 0;
+
+    while (position < length)
+    {
+        char32_t codePoint;
+        std::size_t sequenceLength;
+
+        if (decodeUtf8(view, position, codePoint, sequenceLength))
+        {
+            encodeUtf8(uppercaseCodePoint(codePoint), out + position, sequenceLength);
+        }
+        else
+        {
+            out[position] = text[position];
+        }
+
+        position += sequenceLength;
+    }
+}
+
+
+bool containsNonAscii(std::string_view text)
+{
+    // Eight bytes are checked at a time, by testing their high bits all
+    // at once.
+    constexpr std::uint64_t highBits = 0x8080808080808080ull;
+
+    std::size_t i = 0;
+
+    for (; i + 8 <= text.length(); i += 8)
+    {
+        std::uint64_t block;
+        std::memcpy(&block, text.data() + i, sizeof(block));
+
+        if ((block & highBits) != 0)
+        {
+            return true;
+        }
+    }
+
+    for (; i < text.length(); ++i)
+    {
+        if (static_cast<unsigned char>(text[i]) >= 0x80)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
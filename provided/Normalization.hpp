@@ -0,0 +1,218 @@
+// Normalization.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// The rules for classifying and normalizing characters, shared by
+// everything that reads words (the TextReader's tokenizer, the
+// WordSetLoader, and the dictionary generator) and everything that
+// compares them (the WordPrefilter), so that a word is normalized the same
+// way wherever it comes from, and only once.
+//
+// The ASCII rules don't depend on the locale.  They're looked up in
+// 256-entry tables that are generated at compile time, rather than asking
+// std::isalnum() and std::toupper(), which consult the locale for every
+// character.  Bytes outside of ASCII are never changed by them.
+//
+// Text can also be treated as UTF-8, in which case a multibyte sequence
+// that encodes a letter is treated as a letter, rather than as a
+// separator between words, and letters outside of ASCII are made
+// uppercase, too, by a simple (one letter to one letter) case mapping.
+// Text without any bytes outside of ASCII takes the ASCII path either way.
+
+#ifndef NORMALIZATION_HPP
+#define NORMALIZATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+
+// How a text (or a word file) is to be interpreted.
+enum class TextEncoding
+{
+    Ascii,
+    Utf8
+};
+
+
+// The classes a byte can belong to, as bits of an entry in
+// CHARACTER_CLASSES.
+enum CharacterClass : unsigned char
+{
+    // A letter or digit, which can begin a word.
+    WORD_START = 1,
+
+    // A character that can appear within a word: a letter, digit, hyphen,
+    // or apostrophe.
+    WORD_PART = 2,
+
+    // A character that isn't part of a word's text, so is removed from
+    // the words read from a word file (carriage returns and newlines).
+    LINE_END = 4,
+
+    // The first byte of a multibyte UTF-8 sequence, and the bytes that
+    // continue one.
+    UTF8_LEAD = 8,
+    UTF8_CONTINUATION = 16
+};
+
+
+namespace normalization_detail
+{
+    constexpr std::array<unsigned char, 256> makeCharacterClasses()
+    {
+        std::array<unsigned char, 256> classes{};
+
+        for (unsigned int c = 0; c < 256; ++c)
+        {
+            bool letterOrDigit =
+                (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+
+            if (letterOrDigit)
+            {
+                classes[c] = WORD_START | WORD_PART;
+            }
+            else if (c == '-' || c == '\'')
+            {
+                classes[c] = WORD_PART;
+            }
+            else if (c == '\r' || c == '\n')
+            {
+                classes[c] = LINE_END;
+            }
+            else if (c >= 0xC2 && c <= 0xF4)
+            {
+                classes[c] = UTF8_LEAD;
+            }
+            else if (c >= 0x80 && c <= 0xBF)
+            {
+                classes[c] = UTF8_CONTINUATION;
+            }
+        }
+
+        return classes;
+    }
+
+
+    constexpr std::array<char, 256> makeUppercase()
+    {
+        std::array<char, 256> uppercase{};
+
+        for (unsigned int c = 0; c < 256; ++c)
+        {
+            uppercase[c] = static_cast<char>(c >= 'a' && c <= 'z' ? c - ('a' - 'A') : c);
+        }
+
+        return uppercase;
+    }
+}
+
+
+constexpr std::array<unsigned char, 256> CHARACTER_CLASSES =
+    normalization_detail::makeCharacterClasses();
+
+constexpr std::array<char, 256> UPPERCASE = normalization_detail::makeUppercase();
+
+
+constexpr bool hasClass(char c, CharacterClass characterClass)
+{
+    return (CHARACTER_CLASSES[static_cast<unsigned char>(c)] & characterClass) != 0;
+}
+
+
+constexpr bool isWordStart(char c)
+{
+    return hasClass(c, WORD_START);
+}
+
+
+constexpr bool isWordPart(char c)
+{
+    return hasClass(c, WORD_PART);
+}
+
+
+constexpr char toUppercase(char c)
+{
+    return UPPERCASE[static_cast<unsigned char>(c)];
+}
+
+
+// uppercaseAscii() stores into out a copy of the length bytes of text, with
+// the ASCII letters made uppercase, using SIMD instructions when the
+// processor supports them.  out may be the same as text.
+void uppercaseAscii(const char* text, std::size_t length, char* out);
+
+
+// normalizeWord() returns the word on a line of a word file: the line made
+// uppercase, with any carriage returns and newlines removed.
+inline std::string normalizeWord(std::string_view line)
+{
+    std::string word;
+    word.reserve(line.length());
+
+    for (char c : line)
+    {
+        if (!hasClass(c, LINE_END))
+        {
+            word.push_back(toUppercase(c));
+        }
+    }
+
+    return word;
+}
+
+
+
+// UTF-8
+
+// decodeUtf8() decodes the sequence that begins at the given position in
+// the text, storing its code point into codePoint and its length into
+// length.  It returns false (with a length of 1) if the bytes there are
+// not a valid, shortest-form UTF-8 sequence.
+bool decodeUtf8(
+    std::string_view text, std::size_t position, char32_t& codePoint, std::size_t& length);
+
+
+// encodeUtf8() returns the UTF-8 encoding of a valid code point.
+std::string encodeUtf8(char32_t codePoint);
+
+
+// normalizeWord() can also treat the line as UTF-8, in which case the
+// letters outside of ASCII are made uppercase, too.
+std::string normalizeWord(std::string_view line, TextEncoding encoding);
+
+
+// uppercaseCodePoint() returns the uppercase version of the code point,
+// or the code point itself if it isn't a lowercase letter whose uppercase
+// version is encoded in as many bytes (which it is for the letters of
+// the Latin, Greek, Cyrillic, and Armenian scripts, save for a few
+// exceptions such as the dotless i).
+char32_t uppercaseCodePoint(char32_t codePoint);
+
+
+// uppercaseUtf8() is like uppercaseAscii(), except that the text is
+// treated as UTF-8, so the letters outside of ASCII are made uppercase
+// by uppercaseCodePoint(), too.  Invalid sequences are copied unchanged.
+// Since no letter changes length, out is always the same length as text.
+// Texts that are entirely ASCII are left to uppercaseAscii().
+void uppercaseUtf8(const char* text, std::size_t length, char* out);
+
+
+// isNonAsciiLetter() returns true if the code point, which is not ASCII,
+// is a letter.  This is an approximation of Unicode's definition that
+// covers the letters of the Latin, Greek, Cyrillic, Armenian, Hebrew, and
+// Arabic scripts, along with kana, Hangul syllables, and CJK ideographs.
+bool isNonAsciiLetter(char32_t codePoint);
+
+
+// containsNonAscii() returns true if any byte of the text is outside of
+// ASCII, checking the bytes in blocks.
+bool containsNonAscii(std::string_view text);
+
+
+
+#endif // NORMALIZATION_HPP
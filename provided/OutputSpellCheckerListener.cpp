@@ -13,12 +13,11 @@ OutputSpellCheckerListener::OutputSpellCheckerListener(std::ostream& out)
 
 
 void OutputSpellCheckerListener::misspellingFound(
-    const std::string& word, const std::string& line,
-    const std::vector<std::string>& suggestions)
+    const Misspelling& misspelling, const std::vector<std::string>& suggestions)
 {
     out << std::endl;
-    out << line << std::endl;
-    out << "     word not found: " << word << std::endl;
+    out << misspelling.line << std::endl;
+    out << "     word not found: " << misspelling.word << std::endl;
 
     if (suggestions.size() > 0)
     {
@@ -20,8 +20,7 @@ public:
     OutputSpellCheckerListener(std::ostream& out);
 
     virtual void misspellingFound(
-        const std::string& word, const std::string& line,
-        const std::vector<std::string>& suggestions);
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions);
 
 private:
     std::ostream& out;
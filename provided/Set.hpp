@@ -33,11 +33,38 @@ public:
     virtual void add(const T& element) = 0;
 
 
+    // addAll() adds each of the count elements to the set, as though by
+    // calling add() on each in turn.  Implementations can override it to
+    // take advantage of knowing all of the elements at once (e.g., by
+    // sizing themselves once, or by adding them in parallel).
+    virtual void addAll(const T* elements, unsigned int count)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            add(elements[i]);
+        }
+    }
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.
     virtual bool contains(const T& element) const = 0;
 
 
+    // containsBatch() determines, for each of the count elements, whether
+    // it's in the set, storing the answers into out[0] through
+    // out[count - 1].  By default, this simply asks contains() about each
+    // element in turn, but implementations can override it to overlap the
+    // memory accesses of the independent lookups (e.g., by prefetching).
+    virtual void containsBatch(const T* elements, unsigned int count, bool* out) const
+    {
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            out[i] = contains(elements[i]);
+        }
+    }
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const = 0;
 };
@@ -0,0 +1,64 @@
+// SimdSupport.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Helpers shared by the code that processes text with SIMD instructions
+// (see Normalization.cpp and Tokenizer.cpp).  This isn't meant to be used
+// anywhere else.
+//
+// On x86, SIMD_X86 is defined and the SSE2 and AVX2 intrinsics are
+// available.  SSE2 is part of every x86-64 processor, so it's used without
+// asking; AVX2 isn't, so functions that use it are compiled for it
+// specifically (with __attribute__((target("avx2")))) and only called
+// once hasAVX2() says the processor supports it.
+
+#ifndef SIMDSUPPORT_HPP
+#define SIMDSUPPORT_HPP
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+
+
+#ifdef SIMD_X86
+
+// lessOrEqual() returns a mask with every bit of each byte of x that's less
+// than or equal to the same byte of limit set, comparing them as unsigned.
+inline __m128i lessOrEqual(__m128i x, __m128i limit)
+{
+    return _mm_cmpeq_epi8(_mm_min_epu8(x, limit), x);
+}
+
+
+__attribute__((target("avx2")))
+inline __m256i lessOrEqual256(__m256i x, __m256i limit)
+{
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(x, limit), x);
+}
+
+#endif // SIMD_X86
+
+
+// hasAVX2() returns true if the processor supports AVX2.
+inline bool hasAVX2()
+{
+#ifdef SIMD_X86
+    static const bool supported =
+        []()
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+
+    return supported;
+#else
+    return false;
+#endif
+}
+
+
+
+#endif // SIMDSUPPORT_HPP
@@ -0,0 +1,67 @@
+// SortedDictionary.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include "SortedDictionary.hpp"
+
+
+
+SortedDictionary::SortedDictionary(std::vector<std::string> words)
+{
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    std::size_t length = 0;
+
+    for (const std::string& word : words)
+    {
+        length += word.length();
+    }
+
+    text.reserve(length);
+    offsets.reserve(words.size() + 1);
+
+    for (const std::string& word : words)
+    {
+        offsets.push_back(text.length());
+        text.append(word);
+    }
+
+    offsets.push_back(text.length());
+}
+
+
+std::size_t SortedDictionary::size() const
+{
+    return offsets.size() - 1;
+}
+
+
+std::string_view SortedDictionary::word(std::size_t index) const
+{
+    return std::string_view{text}.substr(offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+
+std::vector<bool> SortedDictionary::findMissing(
+    const std::vector<std::string_view>& sortedWords) const
+{
+    std::vector<bool> missing(sortedWords.size(), true);
+    std::size_t next = 0;
+
+    for (std::size_t i = 0; i < sortedWords.size() && next < size(); ++i)
+    {
+        // Every dictionary word that comes before this one also comes
+        // before all of the words after it, so it can be passed by for good.
+        while (next < size() && word(next) < sortedWords[i])
+        {
+            ++next;
+        }
+
+        missing[i] = next == size() || word(next) != sortedWords[i];
+    }
+
+    return missing;
+}
@@ -0,0 +1,50 @@
+// SortedDictionary.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SortedDictionary holds a dictionary's words in ascending order, with
+// their characters laid end to end in one string, so that a sorted list
+// of other words can be checked against it by merging the two lists in a
+// single sequential pass (see findMissing()), rather than by looking each
+// word up.  Walking through both lists in order, as a merge does, touches
+// memory in the pattern that processors prefetch best, which pays off
+// when there are many words to check at once.
+//
+// Words are compared as std::string_views, so a list to be checked needs
+// to have been sorted the same way.
+
+#ifndef SORTEDDICTIONARY_HPP
+#define SORTEDDICTIONARY_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class SortedDictionary
+{
+public:
+    // Duplicate words are only kept once.
+    explicit SortedDictionary(std::vector<std::string> words);
+
+    std::size_t size() const;
+    std::string_view word(std::size_t index) const;
+
+    // findMissing() takes words in ascending order and returns whether
+    // each of them is missing from the dictionary.
+    std::vector<bool> findMissing(const std::vector<std::string_view>& sortedWords) const;
+
+private:
+    std::string text;
+
+    // The offset of each word's first character in text, followed by the
+    // length of text, so that each word ends where the next one begins.
+    std::vector<std::size_t> offsets;
+};
+
+
+
+#endif // SORTEDDICTIONARY_HPP
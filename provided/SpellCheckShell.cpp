@@ -3,25 +3,38 @@
 // ICS 46 Spring 2017
 // Project #3: Set the Controls for the Heart of the Sun
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "SpellCheckShell.hpp"
-#include "AVLSet.hpp"
-#include "BSTSet.hpp"
+#include "BinarySpellCheckerListener.hpp"
+#include "BufferedOutputSpellCheckerListener.hpp"
+#include "CompiledSet.hpp"
+#include "EmbeddedSet.hpp"
 #include "EmptySet.hpp"
-#include "HashSet.hpp"
-#include "ListSet.hpp"
+#include "JsonLinesSpellCheckerListener.hpp"
 #include "OutputSpellCheckerListener.hpp"
 #include "Set.hpp"
-#include "SkipListSet.hpp"
+#include "SortedDictionary.hpp"
 #include "SpellChecker.hpp"
+#include "StatsSpellCheckerListener.hpp"
 #include "Stopwatch.hpp"
-#include "StringHashing.hpp"
+#include "SuggestionCache.hpp"
 #include "TextFileReader.hpp"
 #include "WordChecker.hpp"
+#include "WordPrefilter.hpp"
 #include "WordSetLoader.hpp"
+#include "WordSetTypes.hpp"
+#include "WorkStealingPool.hpp"
 
 
 
@@ -48,136 +61,815 @@ namespace
     }
 
 
-    std::unique_ptr<Set<std::string>> makeWordSet(const std::string& setType)
+    void requireNonEmptyFileExists(const std::string& filePath)
     {
-        if (setType == "AVL")
+        std::ifstream file{filePath};
+
+        if (file.is_open())
         {
-            return std::make_unique<AVLSet<std::string>>();
+            char c;
+            
+            if (file >> c)
+            {
+                return;
+            }
+            else
+            {
+                throw SpellCheckShell::ShellException{"File is empty: " + filePath};
+            }
         }
-        else if (setType == "BST")
+        else
         {
-            return std::make_unique<BSTSet<std::string>>();
+            throw SpellCheckShell::ShellException{"Cannot open file: " + filePath};
         }
-        else if (setType == "EMPTY")
+    }
+
+
+    bool isStream(const std::string& textFilePath)
+    {
+        if (textFilePath == TextFileReader::STANDARD_INPUT_PATH)
         {
-            return std::make_unique<EmptySet<std::string>>();
+            return true;
         }
-        else if (setType == "HASH ZERO")
+
+        struct stat status;
+        return ::stat(textFilePath.c_str(), &status) == 0 && !S_ISREG(status.st_mode);
+    }
+
+
+    // Text that's streamed, from standard input or a named pipe, can only
+    // be read once, so it isn't opened ahead of time to see whether it's
+    // empty; doing so would consume some of it.
+    void requireReadableText(const std::string& textFilePath)
+    {
+        if (!isStream(textFilePath))
         {
-            return std::make_unique<HashSet<std::string>>(hashStringAsZero);
+            requireNonEmptyFileExists(textFilePath);
         }
-        else if (setType == "HASH SUM")
+    }
+
+
+    enum class OutputType
+    {
+        Display,
+        TimeOnly,
+        Compile,
+        Scaling,
+        Batch
+    };
+
+
+    // Misspellings can be displayed for people to read, or in formats
+    // meant for other programs (see JsonLinesSpellCheckerListener.hpp and
+    // BinarySpellCheckerListener.hpp), or only summarized once checking is
+    // finished (see StatsSpellCheckerListener.hpp).
+    enum class OutputFormat
+    {
+        Text,
+        JsonLines,
+        Binary,
+        Stats
+    };
+
+
+    // The output type can be followed by options on the same line, such
+    // as "DISPLAY --cache=1000".  These are collected into a RunOptions.
+    struct RunOptions
+    {
+        // The capacity of the suggestion cache; zero means no cache.
+        unsigned int suggestionCacheCapacity;
+
+        // Whether a WordPrefilter is built alongside the word set and used
+        // to rule out words before they're looked up.
+        bool usePrefilter;
+
+        // Whether regular files are read ahead asynchronously (through
+        // io_uring, where it's available) rather than mapped into memory.
+        bool readAsynchronously;
+
+        // How the word file and the text are interpreted; as UTF-8, words
+        // can contain letters outside of ASCII, and suggestions can use
+        // any of the letters in the word set.
+        TextEncoding encoding;
+
+        // The number of threads that check the text, each taking a chunk
+        // of it at a time (see SpellChecker::runParallel()).  Streams are
+        // always checked by one thread.  In a batch, each thread instead
+        // takes one whole document at a time.
+        unsigned int threadCount;
+
+        // Whether the text is read, checked, and reported on by separate
+        // threads (see SpellChecker::runPipelined()), in which case the
+        // thread count is the number of checker threads.
+        bool usePipeline;
+
+        // Whether each distinct word in a text is checked only once (see
+        // SpellChecker::runDistinct()), which takes precedence over
+        // checking it on more than one thread.  In a batch, each document
+        // is checked this way.
+        bool checkDistinctWords;
+
+        // Whether the text's distinct words are sorted and merged with a
+        // sorted copy of the dictionary (see SpellChecker::runSortMerge()),
+        // on as many threads as the thread count, rather than looked up in
+        // the word set, which is then used only to find suggestions.  This
+        // takes precedence over every other way of checking the text, and
+        // can't be used on a stream.
+        bool useSortMerge;
+
+        // How the listeners (such as the one that writes the output) are
+        // told of misspellings; see SpellChecker::setNotificationMode().
+        NotificationMode notificationMode;
+
+        // Whether output describing misspellings is collected into a buffer
+        // that's written out in large pieces, rather than line by line.
+        bool bufferOutput;
+
+        // How misspellings are displayed.  In the formats meant for other
+        // programs, everything else the shell prints goes to standard error
+        // instead of standard output, so that standard output contains only
+        // the formatted misspellings.
+        OutputFormat outputFormat;
+
+        // The number of most frequent misspellings listed when they're
+        // summarized.
+        std::size_t topCount;
+
+        // The most suggestions found for each misspelling; zero means that
+        // misspellings are only reported, without looking for suggestions.
+        std::size_t suggestionLimit;
+    };
+
+
+    OutputType makeOutputType(const std::string& outputType)
+    {
+        if (outputType == "DISPLAY")
         {
-            return std::make_unique<HashSet<std::string>>(hashStringAsSum);
+            return OutputType::Display;
         }
-        else if (setType == "HASH PRODUCT")
+        else if (outputType == "TIME")
         {
-            return std::make_unique<HashSet<std::string>>(hashStringAsProduct);
+            return OutputType::TimeOnly;
+        }
+        else if (outputType == "COMPILE")
+        {
+            return OutputType::Compile;
         }
-        else if (setType == "LIST")
+        else if (outputType == "SCALE")
         {
-            return std::make_unique<ListSet<std::string>>();
+            return OutputType::Scaling;
         }
-        else if (setType == "SKIPLIST")
+        else if (outputType == "BATCH")
         {
-            return std::make_unique<SkipListSet<std::string>>();
+            return OutputType::Batch;
         }
         else
         {
-            throw SpellCheckShell::ShellException{"Invalid search structure type: " + setType};
+            throw SpellCheckShell::ShellException{"Invalid output type: " + outputType};
         }
     }
 
-    
-    void requireNonEmptyFileExists(const std::string& filePath)
+
+    unsigned int makeCount(const std::string& option, const std::string& value)
     {
-        std::ifstream file{filePath};
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+        {
+            throw SpellCheckShell::ShellException{"Invalid option: " + option};
+        }
 
-        if (file.is_open())
+        return std::stoul(value);
+    }
+
+
+    OutputFormat makeOutputFormat(const std::string& option, const std::string& value)
+    {
+        if (value == "text")
         {
-            char c;
-            
-            if (file >> c)
+            return OutputFormat::Text;
+        }
+        else if (value == "jsonl")
+        {
+            return OutputFormat::JsonLines;
+        }
+        else if (value == "binary")
+        {
+            return OutputFormat::Binary;
+        }
+        else if (value == "stats")
+        {
+            return OutputFormat::Stats;
+        }
+        else
+        {
+            throw SpellCheckShell::ShellException{"Invalid option: " + option};
+        }
+    }
+
+
+    NotificationMode makeNotificationMode(const std::string& option, const std::string& value)
+    {
+        if (value == "immediate")
+        {
+            return NotificationMode::Immediate;
+        }
+        else if (value == "batched")
+        {
+            return NotificationMode::Batched;
+        }
+        else if (value == "thread")
+        {
+            return NotificationMode::DedicatedThread;
+        }
+        else
+        {
+            throw SpellCheckShell::ShellException{"Invalid option: " + option};
+        }
+    }
+
+
+    RunOptions makeRunOptions(OutputType outputType, std::istream& options)
+    {
+        RunOptions runOptions;
+
+        // Caching suggestions is on by default when displaying output, but
+        // off by default when timing, so that the timing test continues to
+        // measure the search structure unless asked otherwise.
+        bool displaying = outputType == OutputType::Display || outputType == OutputType::Batch;
+
+        runOptions.suggestionCacheCapacity = displaying ? SuggestionCache::DEFAULT_CAPACITY : 0;
+
+        runOptions.usePrefilter = false;
+        runOptions.readAsynchronously = false;
+        runOptions.encoding = TextEncoding::Ascii;
+
+        // A batch uses every processor by default, since its documents are
+        // checked independently of one another.
+        runOptions.threadCount = outputType == OutputType::Batch
+            ? std::max(std::thread::hardware_concurrency(), 1u)
+            : 1;
+
+        runOptions.usePipeline = false;
+        runOptions.checkDistinctWords = false;
+        runOptions.useSortMerge = false;
+        runOptions.notificationMode = NotificationMode::Immediate;
+
+        // Output is buffered by default unless it's going to a terminal,
+        // where someone is presumably watching it appear.
+        runOptions.bufferOutput = !::isatty(STDOUT_FILENO);
+        runOptions.outputFormat = OutputFormat::Text;
+        runOptions.topCount = StatsSpellCheckerListener::DEFAULT_TOP_COUNT;
+        runOptions.suggestionLimit = SpellCheckerListener::ALL_SUGGESTIONS;
+
+        std::string option;
+
+        while (options >> option)
+        {
+            std::string name = option.substr(0, option.find('='));
+            std::string value =
+                name.length() < option.length() ? option.substr(name.length() + 1) : "";
+
+            if (name == "--cache")
             {
-                return;
+                runOptions.suggestionCacheCapacity = makeCount(option, value);
+            }
+            else if (option == "--prefilter")
+            {
+                runOptions.usePrefilter = true;
+            }
+            else if (option == "--io-uring")
+            {
+                runOptions.readAsynchronously = true;
+            }
+            else if (option == "--utf8")
+            {
+                runOptions.encoding = TextEncoding::Utf8;
+            }
+            else if (option == "--pipeline")
+            {
+                runOptions.usePipeline = true;
+            }
+            else if (option == "--distinct")
+            {
+                runOptions.checkDistinctWords = true;
+            }
+            else if (option == "--sort-merge")
+            {
+                runOptions.useSortMerge = true;
+            }
+            else if (option == "--buffered")
+            {
+                runOptions.bufferOutput = true;
+            }
+            else if (option == "--unbuffered")
+            {
+                runOptions.bufferOutput = false;
+            }
+            else if (name == "--suggestions")
+            {
+                runOptions.suggestionLimit = makeCount(option, value);
+            }
+            else if (name == "--format")
+            {
+                runOptions.outputFormat = makeOutputFormat(option, value);
+            }
+            else if (name == "--top")
+            {
+                runOptions.topCount = makeCount(option, value);
+            }
+            else if (name == "--notify")
+            {
+                runOptions.notificationMode = makeNotificationMode(option, value);
+            }
+            else if (name == "--threads")
+            {
+                // Zero threads means one for each of the processor's.
+                runOptions.threadCount = makeCount(option, value);
+
+                if (runOptions.threadCount == 0)
+                {
+                    runOptions.threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+                }
             }
             else
             {
-                throw SpellCheckShell::ShellException{"File is empty: " + filePath};
+                throw SpellCheckShell::ShellException{"Invalid option: " + option};
             }
         }
+
+        return runOptions;
+    }
+
+
+    std::shared_ptr<SuggestionCache> makeSuggestionCache(const RunOptions& runOptions)
+    {
+        if (runOptions.suggestionCacheCapacity == 0)
+        {
+            return nullptr;
+        }
         else
         {
-            throw SpellCheckShell::ShellException{"Cannot open file: " + filePath};
+            return std::make_shared<SuggestionCache>(runOptions.suggestionCacheCapacity);
         }
     }
 
 
-    enum class OutputType
+    // loadWordSet() loads the word set (and the prefilter, if there is
+    // one), returning the letters outside of ASCII that its words use.
+    std::vector<std::string> loadWordSet(
+        const std::string& wordFilePath, Set<std::string>& wordSet,
+        WordPrefilter& prefilter, const RunOptions& runOptions)
     {
-        Display,
-        TimeOnly
-    };
+        try
+        {
+            WordSetLoader loader{runOptions.readAsynchronously, runOptions.encoding};
 
+            if (runOptions.usePrefilter)
+            {
+                loader.load(wordFilePath, wordSet, prefilter);
+            }
+            else
+            {
+                loader.load(wordFilePath, wordSet);
+            }
 
-    OutputType makeOutputType(const std::string& outputType)
+            return loader.alphabet();
+        }
+        catch (CompiledSet::FormatException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+        catch (WordSetLoader::FileException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+    }
+
+
+    // loadSortedDictionary() returns the words held by the loaded word set
+    // as a SortedDictionary if the options call for one, or nullptr
+    // otherwise.
+    std::unique_ptr<SortedDictionary> loadSortedDictionary(
+        const std::string& wordFilePath, const Set<std::string>& wordSet,
+        const RunOptions& runOptions)
     {
-        if (outputType == "DISPLAY")
+        if (!runOptions.useSortMerge)
         {
-            return OutputType::Display;
+            return nullptr;
         }
-        else if (outputType == "TIME")
+
+        try
         {
-            return OutputType::TimeOnly;
+            WordSetLoader loader{runOptions.readAsynchronously, runOptions.encoding};
+            return std::make_unique<SortedDictionary>(loader.loadedWords(wordFilePath, wordSet));
+        }
+        catch (WordSetLoader::FileException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+    }
+
+
+    WordChecker makeWordChecker(
+        const Set<std::string>& wordSet, const WordPrefilter& prefilter,
+        const std::vector<std::string>& alphabet, const RunOptions& runOptions)
+    {
+        WordChecker wordChecker =
+            runOptions.usePrefilter ? WordChecker{wordSet, prefilter} : WordChecker{wordSet};
+
+        wordChecker.addLetters(alphabet);
+        return wordChecker;
+    }
+
+
+    std::shared_ptr<SpellCheckerListener> makeOutputListener(const RunOptions& runOptions)
+    {
+        if (runOptions.outputFormat == OutputFormat::JsonLines)
+        {
+            return std::make_shared<JsonLinesSpellCheckerListener>(std::cout);
+        }
+        else if (runOptions.outputFormat == OutputFormat::Binary)
+        {
+            return std::make_shared<BinarySpellCheckerListener>(std::cout);
+        }
+        else if (runOptions.outputFormat == OutputFormat::Stats)
+        {
+            return std::make_shared<StatsSpellCheckerListener>(std::cout, runOptions.topCount);
+        }
+        else if (runOptions.bufferOutput)
+        {
+            return std::make_shared<BufferedOutputSpellCheckerListener>(std::cout);
         }
         else
         {
-            throw SpellCheckShell::ShellException{"Invalid output type: " + outputType};
+            return std::make_shared<OutputSpellCheckerListener>(std::cout);
+        }
+    }
+
+
+    // statusStream() returns the stream that messages about the shell's
+    // progress are written to.
+    std::ostream& statusStream(const RunOptions& runOptions)
+    {
+        return runOptions.outputFormat == OutputFormat::JsonLines
+            || runOptions.outputFormat == OutputFormat::Binary ? std::cerr : std::cout;
+    }
+
+
+    // sortAndMerge() checks the spelling of the words in the text by
+    // merging them with the sorted dictionary, on the given number of
+    // threads, reading the text as the options say.
+    void sortAndMerge(
+        SpellChecker& spellChecker, const WordChecker& wordChecker,
+        const SortedDictionary& dictionary, const std::string& textFilePath,
+        unsigned int threadCount, const RunOptions& runOptions)
+    {
+        try
+        {
+            spellChecker.runSortMerge(
+                wordChecker, dictionary, textFilePath, threadCount,
+                runOptions.readAsynchronously, runOptions.encoding);
+        }
+        catch (SpellChecker::TextChangedException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+    }
+
+
+    // checkSpelling() checks the spelling of the words in the text, either
+    // by merging them with the sorted dictionary (if there is one), one
+    // distinct word at a time, through a pipeline, or in parallel if the
+    // options call for more than one thread and the text isn't a stream.
+    void checkSpelling(
+        SpellChecker& spellChecker, const WordChecker& wordChecker,
+        const SortedDictionary* dictionary,
+        const std::string& textFilePath, const RunOptions& runOptions)
+    {
+        if (dictionary != nullptr)
+        {
+            // The text is read twice, which a stream can't do.
+            if (isStream(textFilePath))
+            {
+                throw SpellCheckShell::ShellException{
+                    "Cannot sort and merge a stream: " + textFilePath};
+            }
+
+            sortAndMerge(
+                spellChecker, wordChecker, *dictionary, textFilePath,
+                runOptions.threadCount, runOptions);
+        }
+        else if (runOptions.checkDistinctWords)
+        {
+            TextFileReader reader{
+                textFilePath, runOptions.readAsynchronously, runOptions.encoding};
+
+            spellChecker.runDistinct(wordChecker, reader);
+        }
+        else if (runOptions.usePipeline)
+        {
+            TextFileReader reader{
+                textFilePath, runOptions.readAsynchronously, runOptions.encoding};
+
+            spellChecker.runPipelined(wordChecker, reader, runOptions.threadCount);
+        }
+        else if (runOptions.threadCount > 1 && !isStream(textFilePath))
+        {
+            spellChecker.runParallel(
+                wordChecker, textFilePath, runOptions.threadCount, runOptions.encoding);
+        }
+        else
+        {
+            TextFileReader reader{
+                textFilePath, runOptions.readAsynchronously, runOptions.encoding};
+
+            spellChecker.run(wordChecker, reader);
         }
     }
 
 
     void runWithDisplay(
         Set<std::string>& wordSet,
-        const std::string& wordFilePath, const std::string& textFilePath)
+        const std::string& wordFilePath, const std::string& textFilePath,
+        const RunOptions& runOptions)
     {
         SpellChecker spellChecker;
+        spellChecker.setNotificationMode(runOptions.notificationMode);
+        spellChecker.setSuggestionLimit(runOptions.suggestionLimit);
+        spellChecker.setSuggestionCache(makeSuggestionCache(runOptions));
 
-        std::shared_ptr<OutputSpellCheckerListener> output =
-            std::make_shared<OutputSpellCheckerListener>(std::cout);
-
+        std::shared_ptr<SpellCheckerListener> output = makeOutputListener(runOptions);
         spellChecker.addObserver(output);
 
+        std::ostream& status = statusStream(runOptions);
+
+        status << std::endl;
+        status << "Loading word set from " << wordFilePath << " ..." << std::endl;
+
+        WordPrefilter prefilter;
+        std::vector<std::string> alphabet =
+            loadWordSet(wordFilePath, wordSet, prefilter, runOptions);
+
+        std::unique_ptr<SortedDictionary> dictionary =
+            loadSortedDictionary(wordFilePath, wordSet, runOptions);
+
+        status << "Checking spelling in " << textFilePath << " ..." << std::endl;
+
+        WordChecker wordChecker = makeWordChecker(wordSet, prefilter, alphabet, runOptions);
+        checkSpelling(spellChecker, wordChecker, dictionary.get(), textFilePath, runOptions);
+    }
+
+
+    // listBatchDocuments() returns the paths of the documents in a batch,
+    // which is either a directory (whose regular files are checked, in
+    // order by name) or a file listing the documents' paths, one per line.
+    std::vector<std::string> listBatchDocuments(const std::string& batchPath)
+    {
+        std::vector<std::string> documentPaths;
+
+        struct stat status;
+
+        if (::stat(batchPath.c_str(), &status) == 0 && S_ISDIR(status.st_mode))
+        {
+            DIR* directory = ::opendir(batchPath.c_str());
+
+            if (directory == nullptr)
+            {
+                throw SpellCheckShell::ShellException{"Cannot open directory: " + batchPath};
+            }
+
+            while (dirent* entry = ::readdir(directory))
+            {
+                std::string name = entry->d_name;
+
+                if (name != "." && name != "..")
+                {
+                    documentPaths.push_back(batchPath + "/" + name);
+                }
+            }
+
+            ::closedir(directory);
+
+            std::sort(documentPaths.begin(), documentPaths.end());
+
+            documentPaths.erase(
+                std::remove_if(
+                    documentPaths.begin(), documentPaths.end(),
+                    [](const std::string& path)
+                    {
+                        struct stat status;
+                        return ::stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode);
+                    }),
+                documentPaths.end());
+        }
+        else
+        {
+            requireNonEmptyFileExists(batchPath);
+
+            std::ifstream listFile{batchPath};
+            std::string line;
+
+            while (std::getline(listFile, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                {
+                    line.pop_back();
+                }
+
+                if (line.empty())
+                {
+                    continue;
+                }
+
+                struct stat status;
+
+                if (::stat(line.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+                {
+                    throw SpellCheckShell::ShellException{"Cannot open file: " + line};
+                }
+
+                documentPaths.push_back(line);
+            }
+        }
+
+        return documentPaths;
+    }
+
+
+    // runBatch() checks the spelling of every document in a batch against
+    // a word set that's loaded only once.  The documents are checked on a
+    // WorkStealingPool, largest first, each by its own SpellChecker (though
+    // they share a suggestion cache).  Each document's output is collected
+    // separately and written as soon as it and every document before it
+    // are done, so the output is the same regardless of the number of
+    // threads, and in the same order as the documents were listed.
+    void runBatch(
+        Set<std::string>& wordSet,
+        const std::string& wordFilePath, const std::string& batchPath,
+        const RunOptions& runOptions)
+    {
+        // A batch's output is divided up by document, which only the text
+        // format has a way to show.
+        if (runOptions.outputFormat != OutputFormat::Text)
+        {
+            throw SpellCheckShell::ShellException{"A batch can only be displayed as text"};
+        }
+
+        std::vector<std::string> documentPaths = listBatchDocuments(batchPath);
+
         std::cout << std::endl;
         std::cout << "Loading word set from " << wordFilePath << " ..." << std::endl;
 
-        WordSetLoader{}.load(wordFilePath, wordSet);
+        WordPrefilter prefilter;
+        std::vector<std::string> alphabet =
+            loadWordSet(wordFilePath, wordSet, prefilter, runOptions);
+
+        std::unique_ptr<SortedDictionary> dictionary =
+            loadSortedDictionary(wordFilePath, wordSet, runOptions);
 
-        std::cout << "Checking spelling in " << textFilePath << " ..." << std::endl;
+        WordChecker wordChecker = makeWordChecker(wordSet, prefilter, alphabet, runOptions);
+        std::shared_ptr<SuggestionCache> suggestionCache = makeSuggestionCache(runOptions);
+
+        WorkStealingPool pool{runOptions.threadCount};
+
+        std::cout << "Checking spelling in " << documentPaths.size()
+                  << " documents from " << batchPath
+                  << " using " << pool.threadCount() << " thread(s) ..." << std::endl;
+
+        std::vector<std::size_t> sizes;
+
+        for (const std::string& documentPath : documentPaths)
+        {
+            struct stat status;
+            sizes.push_back(::stat(documentPath.c_str(), &status) == 0 ? status.st_size : 0);
+        }
 
-        WordChecker wordChecker{wordSet};
-        TextFileReader reader{textFilePath};
+        std::mutex outputMutex;
+        std::vector<std::string> outputs(documentPaths.size());
+        std::vector<bool> done(documentPaths.size(), false);
+        std::size_t nextOutput = 0;
 
-        spellChecker.run(wordChecker, reader);
+        pool.run(
+            sizes,
+            [&](std::size_t index)
+            {
+                std::ostringstream out;
+                out << std::endl;
+                out << "Checking spelling in " << documentPaths[index] << " ..." << std::endl;
+
+                std::shared_ptr<OutputSpellCheckerListener> output =
+                    std::make_shared<OutputSpellCheckerListener>(out);
+
+                SpellChecker spellChecker;
+                spellChecker.setNotificationMode(runOptions.notificationMode);
+                spellChecker.setSuggestionLimit(runOptions.suggestionLimit);
+                spellChecker.setSuggestionCache(suggestionCache);
+                spellChecker.addObserver(output);
+
+                // The documents are already being checked on every thread,
+                // so each is sorted and merged on only one.
+                if (dictionary)
+                {
+                    sortAndMerge(
+                        spellChecker, wordChecker, *dictionary, documentPaths[index],
+                        1, runOptions);
+                }
+                else
+                {
+                    TextFileReader reader{
+                        documentPaths[index], runOptions.readAsynchronously, runOptions.encoding};
+
+                    if (runOptions.checkDistinctWords)
+                    {
+                        spellChecker.runDistinct(wordChecker, reader);
+                    }
+                    else
+                    {
+                        spellChecker.run(wordChecker, reader);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock{outputMutex};
+
+                outputs[index] = out.str();
+                done[index] = true;
+
+                for (; nextOutput < outputs.size() && done[nextOutput]; ++nextOutput)
+                {
+                    std::cout << outputs[nextOutput];
+                    outputs[nextOutput] = std::string{};
+                }
+            });
+
+        std::cout.flush();
+    }
+
+
+    // runCompile() compiles the words in the word file into a dictionary
+    // that's written to the given file, which can then be given as the word
+    // file for later runs, and used in place by a COMPILED search structure.
+    void runCompile(
+        const std::string& wordFilePath, const std::string& compiledFilePath,
+        const RunOptions& runOptions)
+    {
+        std::cout << std::endl;
+        std::cout << "Compiling word set from " << wordFilePath
+                  << " into " << compiledFilePath << " ..." << std::endl;
+
+        CompiledSet compiledSet;
+        WordPrefilter prefilter;
+        loadWordSet(wordFilePath, compiledSet, prefilter, runOptions);
+
+        if (!compiledSet.save(compiledFilePath))
+        {
+            throw SpellCheckShell::ShellException{"Cannot write file: " + compiledFilePath};
+        }
+
+        // Since the checksum isn't verified each time the dictionary is
+        // opened, it's verified once here, as soon as it's been written.
+        try
+        {
+            CompiledSet{}.open(compiledFilePath, true);
+        }
+        catch (CompiledSet::FormatException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+
+        std::cout << "Compiled " << compiledSet.size() << " words" << std::endl;
     }
 
 
     void runTimingTest(
         Set<std::string>& wordSet,
-        const std::string& wordFilePath, const std::string& textFilePath)
+        const std::string& wordFilePath, const std::string& textFilePath,
+        const RunOptions& runOptions)
     {
+        // The timing test reads the text twice, which a stream can't do.
+        if (isStream(textFilePath))
+        {
+            throw SpellCheckShell::ShellException{
+                "Cannot run a timing test on a stream: " + textFilePath};
+        }
+
         std::cout << std::endl;
 
         SpellChecker spellChecker;
+        spellChecker.setNotificationMode(runOptions.notificationMode);
+        spellChecker.setSuggestionLimit(runOptions.suggestionLimit);
 
         Stopwatch stopwatch;
 
         std::cout << "Loading word set from " << wordFilePath
                   << " into search structure ..." << std::endl;
 
+        WordPrefilter prefilter;
+        std::vector<std::string> alphabet;
+        std::unique_ptr<SortedDictionary> dictionary;
+
         {
             stopwatch.start();
-            WordSetLoader{}.load(wordFilePath, wordSet);
+            alphabet = loadWordSet(wordFilePath, wordSet, prefilter, runOptions);
+            dictionary = loadSortedDictionary(wordFilePath, wordSet, runOptions);
             stopwatch.stop();
         }
 
@@ -186,23 +878,34 @@ namespace
         std::cout << "Checking spelling of words in " << textFilePath
                   << " using search structure ..." << std::endl;
 
+        std::shared_ptr<SuggestionCache> wordSetCache = makeSuggestionCache(runOptions);
+        spellChecker.setSuggestionCache(wordSetCache);
+
         {
             stopwatch.start();
-            WordChecker wordChecker{wordSet};
-            TextFileReader reader{textFilePath};
-            spellChecker.run(wordChecker, reader);
+            WordChecker wordChecker =
+                makeWordChecker(wordSet, prefilter, alphabet, runOptions);
+            checkSpelling(spellChecker, wordChecker, dictionary.get(), textFilePath, runOptions);
             stopwatch.stop();
         }
 
         double wordSetSpellCheckDuration = stopwatch.lastDuration();
 
         EmptySet<std::string> emptySet;
+        WordPrefilter emptySetPrefilter;
+        std::vector<std::string> emptySetAlphabet;
+
+        // When sorting and merging, the empty set's counterpart is an empty
+        // dictionary.
+        std::unique_ptr<SortedDictionary> emptyDictionary = runOptions.useSortMerge
+            ? std::make_unique<SortedDictionary>(std::vector<std::string>{})
+            : nullptr;
         
         std::cout << "Loading word set from " << wordFilePath
                   << " into empty set ..." << std::endl;
         {
             stopwatch.start();
-            WordSetLoader{}.load(wordFilePath, emptySet);
+            emptySetAlphabet = loadWordSet(wordFilePath, emptySet, emptySetPrefilter, runOptions);
             stopwatch.stop();
         }
 
@@ -211,11 +914,14 @@ namespace
         std::cout << "Checking spelling of words in " << textFilePath
                   << " using empty set ..." << std::endl;
 
+        spellChecker.setSuggestionCache(makeSuggestionCache(runOptions));
+
         {
             stopwatch.start();
-            WordChecker wordChecker{emptySet};
-            TextFileReader reader{textFilePath};
-            spellChecker.run(wordChecker, reader);
+            WordChecker wordChecker =
+                makeWordChecker(emptySet, emptySetPrefilter, emptySetAlphabet, runOptions);
+            checkSpelling(
+                spellChecker, wordChecker, emptyDictionary.get(), textFilePath, runOptions);
             stopwatch.stop();
         }
 
@@ -266,6 +972,126 @@ namespace
                      - (emptySetLoadDuration + emptySetSpellCheckDuration) << "usec";
 
         std::cout << std::endl;
+
+        if (wordSetCache)
+        {
+            std::cout << std::endl;
+            std::cout << "Suggestion cache (capacity " << wordSetCache->capacity() << "): "
+                      << wordSetCache->hits() << " hits, "
+                      << wordSetCache->misses() << " misses" << std::endl;
+        }
+    }
+
+
+    // runScalingTest() loads the word set once, then times checking the
+    // text one line at a time and then in parallel with 1, 2, 4, ... threads,
+    // up to the number given by --threads (or one for each of the
+    // processor's), showing how each compares to the first.
+    void runScalingTest(
+        Set<std::string>& wordSet,
+        const std::string& wordFilePath, const std::string& textFilePath,
+        const RunOptions& runOptions)
+    {
+        if (isStream(textFilePath))
+        {
+            throw SpellCheckShell::ShellException{
+                "Cannot run a scaling test on a stream: " + textFilePath};
+        }
+
+        unsigned int maxThreadCount = runOptions.threadCount > 1
+            ? runOptions.threadCount
+            : std::max(std::thread::hardware_concurrency(), 1u);
+
+        std::cout << std::endl;
+        std::cout << "Loading word set from " << wordFilePath
+                  << " into search structure ..." << std::endl;
+
+        WordPrefilter prefilter;
+        std::vector<std::string> alphabet =
+            loadWordSet(wordFilePath, wordSet, prefilter, runOptions);
+
+        WordChecker wordChecker = makeWordChecker(wordSet, prefilter, alphabet, runOptions);
+
+        Stopwatch stopwatch;
+
+        std::cout << "Checking spelling of words in " << textFilePath
+                  << " sequentially ..." << std::endl;
+
+        {
+            SpellChecker spellChecker;
+            spellChecker.setNotificationMode(runOptions.notificationMode);
+            spellChecker.setSuggestionLimit(runOptions.suggestionLimit);
+            spellChecker.setSuggestionCache(makeSuggestionCache(runOptions));
+            TextFileReader reader{
+                textFilePath, runOptions.readAsynchronously, runOptions.encoding};
+
+            stopwatch.start();
+            spellChecker.run(wordChecker, reader);
+            stopwatch.stop();
+        }
+
+        double sequentialDuration = stopwatch.lastDuration();
+
+        std::vector<unsigned int> threadCounts;
+
+        for (unsigned int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+        {
+            threadCounts.push_back(threadCount);
+        }
+
+        threadCounts.push_back(maxThreadCount);
+
+        std::vector<double> parallelDurations;
+
+        for (unsigned int threadCount : threadCounts)
+        {
+            std::cout << "Checking spelling of words in " << textFilePath
+                      << " using " << threadCount << " thread(s) ..." << std::endl;
+
+            SpellChecker spellChecker;
+            spellChecker.setNotificationMode(runOptions.notificationMode);
+            spellChecker.setSuggestionLimit(runOptions.suggestionLimit);
+            spellChecker.setSuggestionCache(makeSuggestionCache(runOptions));
+
+            stopwatch.start();
+            spellChecker.runParallel(
+                wordChecker, textFilePath, threadCount, runOptions.encoding);
+            stopwatch.stop();
+
+            parallelDurations.push_back(stopwatch.lastDuration());
+        }
+
+        std::cout << std::endl;
+        std::cout << std::endl;
+        std::cout << "RESULTS" << std::endl;
+
+        std::cout << "               SpellCheckTime     Speedup" << std::endl;
+
+        std::cout << std::left << std::setw(12) << "Sequential";
+
+        std::cout << std::right << std::fixed << std::setprecision(0) << std::setw(15)
+                  << sequentialDuration << "usec";
+
+        std::cout << std::right << std::fixed << std::setprecision(2) << std::setw(11)
+                  << 1.0 << "x";
+
+        std::cout << std::endl;
+
+        for (std::size_t i = 0; i < threadCounts.size(); ++i)
+        {
+            std::string label = std::to_string(threadCounts[i])
+                + (threadCounts[i] == 1 ? " thread" : " threads");
+
+            std::cout << std::left << std::setw(12) << label;
+
+            std::cout << std::right << std::fixed << std::setprecision(0) << std::setw(15)
+                      << parallelDurations[i] << "usec";
+
+            std::cout << std::right << std::fixed << std::setprecision(2) << std::setw(11)
+                      << sequentialDuration / parallelDurations[i] << "x";
+
+            std::cout << std::endl;
+        }
     }
 }
 
@@ -273,31 +1099,83 @@ namespace
 
 void SpellCheckShell::run()
 {
-    std::unique_ptr<Set<std::string>> wordSet = makeWordSet(readString());
+    // When the text to be checked is standard input, it follows these
+    // lines on it and is read directly from its file descriptor.  Leaving
+    // standard input unbuffered ensures that reading these lines doesn't
+    // also consume the beginning of the text.
+    std::setvbuf(stdin, nullptr, _IONBF, 0);
+
+    std::string setType = readString();
+    std::unique_ptr<Set<std::string>> wordSet = makeWordSet(setType);
 
-    if (!wordSet->isImplemented())
+    if (!wordSet)
+    {
+        throw SpellCheckShell::ShellException{"Invalid search structure type: " + setType};
+    }
+    else if (!wordSet->isImplemented())
     {
         throw SpellCheckShell::ShellException{
             "Search structure type not implemented (did you change isImplemented() to return true?)"};
     }
 
+    // An EMBEDDED search structure is built into the program, so it needs
+    // no word file.
     std::string wordFilePath = readString();
-    requireNonEmptyFileExists(wordFilePath);
 
+    if (dynamic_cast<EmbeddedSet*>(wordSet.get()) == nullptr)
+    {
+        requireNonEmptyFileExists(wordFilePath);
+    }
+
+    // When compiling a dictionary, the third line names the file that the
+    // compiled dictionary is written to, rather than a text to check, and
+    // a batch names a directory or a list of documents, so it's not
+    // checked until the output type is known.
     std::string textFilePath = readString();
-    requireNonEmptyFileExists(textFilePath);
 
-    OutputType outputType = makeOutputType(readString());
+    std::istringstream outputLine{readString()};
+
+    std::string outputTypeName;
+    outputLine >> outputTypeName;
 
-    switch (outputType)
+    OutputType outputType = makeOutputType(outputTypeName);
+    RunOptions runOptions = makeRunOptions(outputType, outputLine);
+
+    if (outputType != OutputType::Compile && outputType != OutputType::Batch)
+    {
+        requireReadableText(textFilePath);
+    }
+
+    // A compiled dictionary is only checked as it's used, so damage to it
+    // can be found at any point.
+    try
     {
-    case OutputType::Display:
-        runWithDisplay(*wordSet, wordFilePath, textFilePath);
-        break;
+        switch (outputType)
+        {
+        case OutputType::Display:
+            runWithDisplay(*wordSet, wordFilePath, textFilePath, runOptions);
+            break;
+
+        case OutputType::TimeOnly:
+            runTimingTest(*wordSet, wordFilePath, textFilePath, runOptions);
+            break;
 
-    case OutputType::TimeOnly:
-        runTimingTest(*wordSet, wordFilePath, textFilePath);
-        break;
+        case OutputType::Compile:
+            runCompile(wordFilePath, textFilePath, runOptions);
+            break;
+
+        case OutputType::Scaling:
+            runScalingTest(*wordSet, wordFilePath, textFilePath, runOptions);
+            break;
+
+        case OutputType::Batch:
+            runBatch(*wordSet, wordFilePath, textFilePath, runOptions);
+            break;
+        }
+    }
+    catch (CompiledSet::FormatException& e)
+    {
+        throw SpellCheckShell::ShellException{e.reason()};
     }
 }
 
@@ -3,34 +3,946 @@
 // ICS 46 Spring 2017
 // Project #3: Set the Controls for the Heart of the Sun
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
 #include "SpellChecker.hpp"
+#include "MappedFile.hpp"
+#include "MpscRing.hpp"
+#include "SpscRing.hpp"
+#include "TextChunks.hpp"
+#include "TextReader.hpp"
+#include "ViewLineSource.hpp"
+#include "WordTable.hpp"
 
 
 
+namespace
+{
+    // A FoundMisspelling is a Misspelling found by one of runParallel()'s
+    // threads, kept until it's passed on to the listeners.  The line is a
+    // view into the mapped text, but the word is copied, since the reader
+    // that found it reuses its buffers.  The line number and offset are
+    // relative to the beginning of the chunk.
+    struct FoundMisspelling
+    {
+        std::string word;
+        std::string_view line;
+        unsigned long lineNumber;
+        std::size_t lineOffset;
+        std::size_t column;
+        std::vector<std::string> suggestions;
+    };
+
+
+    struct ChunkResult
+    {
+        std::vector<FoundMisspelling> misspellings;
+
+        // The number of newlines in the chunk, which tells how its line
+        // numbers relate to the text's.
+        unsigned long newlineCount;
+
+        unsigned long wordCount;
+
+        // Set if checking the chunk failed, in which case the exception is
+        // rethrown when the chunk's turn comes to be delivered.
+        std::exception_ptr failure;
+
+        bool done;
+    };
+
+
+    // A PipelineBatch carries a run of consecutive words through
+    // runPipelined()'s stages.  The words (uppercased) and the lines they're
+    // on are copied into the batch, since the reader reuses its buffers.
+    // Misspelled words' indexes and suggestions are added by a checker.
+    struct PipelineLine
+    {
+        std::size_t start;
+        std::size_t length;
+        unsigned long lineNumber;
+        std::size_t lineOffset;
+    };
+
+
+    struct PipelineWord
+    {
+        std::size_t start;
+        std::size_t length;
+        std::size_t lineIndex;
+        std::size_t column;
+    };
+
+
+    struct PipelineMisspelling
+    {
+        std::size_t wordIndex;
+        std::vector<std::string> suggestions;
+    };
+
+
+    struct PipelineBatch
+    {
+        std::size_t sequence;
+
+        std::string lineText;
+        std::vector<PipelineLine> lines;
+
+        std::string wordText;
+        std::vector<PipelineWord> words;
+
+        std::vector<PipelineMisspelling> misspellings;
+    };
+
+
+    // inParallel() calls task with each index from 0 to count - 1, each on
+    // its own thread (one of which is the calling thread).  If any of them
+    // throws an exception, the first is rethrown once they've all finished.
+    template <typename Task>
+    void inParallel(std::size_t count, Task task)
+    {
+        std::vector<std::exception_ptr> failures(count);
+        std::vector<std::thread> threads;
+
+        auto run = [&](std::size_t i)
+        {
+            try
+            {
+                task(i);
+            }
+            catch (...)
+            {
+                failures[i] = std::current_exception();
+            }
+        };
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            threads.emplace_back(run, i);
+        }
+
+        if (count > 0)
+        {
+            run(0);
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (const std::exception_ptr& failure : failures)
+        {
+            if (failure)
+            {
+                std::rethrow_exception(failure);
+            }
+        }
+    }
+
+
+    // sortInParallel() sorts the values by splitting them into one run for
+    // each thread and sorting the runs at the same time, then merging pairs
+    // of runs (also at the same time) until there's only one left.
+    template <typename T>
+    void sortInParallel(std::vector<T>& values, unsigned int threadCount)
+    {
+        std::size_t runCount = std::min<std::size_t>(threadCount, values.size());
+
+        if (runCount <= 1)
+        {
+            std::sort(values.begin(), values.end());
+            return;
+        }
+
+        // Run i is the values from bounds[i] up to (but not including)
+        // bounds[i + 1].
+        std::vector<std::size_t> bounds;
+
+        for (std::size_t i = 0; i <= runCount; ++i)
+        {
+            bounds.push_back(values.size() * i / runCount);
+        }
+
+        auto begin = values.begin();
+
+        inParallel(
+            runCount,
+            [&](std::size_t run)
+            {
+                std::sort(begin + bounds[run], begin + bounds[run + 1]);
+            });
+
+        while (bounds.size() > 2)
+        {
+            inParallel(
+                (bounds.size() - 1) / 2,
+                [&](std::size_t pair)
+                {
+                    std::inplace_merge(
+                        begin + bounds[pair * 2], begin + bounds[pair * 2 + 1],
+                        begin + bounds[pair * 2 + 2]);
+                });
+
+            std::vector<std::size_t> mergedBounds;
+
+            for (std::size_t i = 0; i < bounds.size(); i += 2)
+            {
+                mergedBounds.push_back(bounds[i]);
+            }
+
+            if (mergedBounds.back() != bounds.back())
+            {
+                mergedBounds.push_back(bounds.back());
+            }
+
+            bounds.swap(mergedBounds);
+        }
+    }
+
+
+    // keepTrying() calls attempt until it returns true, returning true, or
+    // until the pipeline is stopped, returning false.  Spinning briefly
+    // catches the common case where the other side is just about to catch
+    // up; after that, the thread yields, then sleeps, so that a stage
+    // that's waiting for a long time doesn't take the processor away from
+    // the others.
+    template <typename Attempt>
+    bool keepTrying(Attempt attempt, const std::atomic<bool>& stopped)
+    {
+        for (unsigned int tries = 0; !attempt(); ++tries)
+        {
+            if (stopped.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            else if (tries >= 1024)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds{50});
+            }
+            else if (tries >= 64)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        return true;
+    }
+}
+
+
+
+SpellChecker::TextChangedException::TextChangedException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+std::string SpellChecker::TextChangedException::reason() const
+{
+    return reason_;
+}
+
+
+SpellChecker::SpellChecker()
+    : notificationMode{NotificationMode::Immediate},
+      suggestionLimit{SpellCheckerListener::ALL_SUGGESTIONS},
+      suggestionCount{SpellCheckerListener::ALL_SUGGESTIONS},
+      checkedWordCount{0}
+{
+}
+
+
 void SpellChecker::run(const WordChecker& wordChecker, TextFileReader& reader)
 {
-    while (!reader.noMoreWords())
+    notifying(
+        [&]()
+        {
+            while (!reader.noMoreWords())
+            {
+                const std::string& word = reader.currentWordView();
+
+                if (!wordChecker.wordExists(word))
+                {
+                    Misspelling misspelling{
+                        word, reader.currentLineView(),
+                        reader.currentLineNumber(), reader.currentLineOffset(),
+                        reader.currentColumn(), word.length()};
+
+                    notifyMisspellingFound(misspelling, findSuggestions(wordChecker, word));
+                }
+
+                ++checkedWordCount;
+                reader.advanceToNextWord();
+            }
+        });
+}
+
+
+void SpellChecker::runParallel(
+    const WordChecker& wordChecker, const std::string& textFilePath,
+    unsigned int threadCount, TextEncoding encoding)
+{
+    notifying(
+        [&]()
+        {
+            threadCount = std::max(threadCount, 1u);
+
+            MappedFile file{textFilePath};
+            std::string_view text = file.contents();
+
+            // There are always a few chunks per thread, even in a small text, so
+            // that a thread that's given a slow chunk doesn't hold up the others.
+            unsigned int chunkCount = std::max<std::size_t>(
+                (text.length() + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE,
+                threadCount * PARALLEL_CHUNKS_AHEAD);
+
+            std::vector<std::string_view> chunks = splitIntoChunks(text, chunkCount);
+            std::vector<ChunkResult> results(chunks.size());
+
+            std::mutex mutex;
+            std::condition_variable chunkDone;
+            std::condition_variable chunkDelivered;
+
+            std::atomic<std::size_t> nextChunk{0};
+            std::size_t deliveredCount = 0;
+            std::size_t window = threadCount * PARALLEL_CHUNKS_AHEAD;
+
+            auto checkChunks = [&]()
+            {
+                std::size_t index;
+
+                while ((index = nextChunk++) < chunks.size())
+                {
+                    {
+                        std::unique_lock<std::mutex> lock{mutex};
+                        chunkDelivered.wait(
+                            lock, [&]() { return index < deliveredCount + window; });
+                    }
+
+                    std::string_view chunk = chunks[index];
+                    ChunkResult& result = results[index];
+                    result.newlineCount = std::count(chunk.begin(), chunk.end(), '\n');
+
+                    try
+                    {
+                        TextReader reader{std::make_unique<ViewLineSource>(chunk), encoding};
+
+                        for (; !reader.noMoreWords(); reader.advanceToNextWord())
+                        {
+                            const std::string& word = reader.currentWord();
+
+                            if (!wordChecker.wordExists(word))
+                            {
+                                result.misspellings.push_back(FoundMisspelling{
+                                    word, reader.currentLine(),
+                                    reader.currentLineNumber(), reader.currentLineOffset(),
+                                    reader.currentColumn(), findSuggestions(wordChecker, word)});
+                            }
+
+                            ++result.wordCount;
+                        }
+                    }
+                    catch (...)
+                    {
+                        result.failure = std::current_exception();
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock{mutex};
+                        result.done = true;
+                    }
+
+                    chunkDone.notify_all();
+                }
+            };
+
+            std::vector<std::thread> threads;
+
+            for (unsigned int i = 0; i < threadCount; ++i)
+            {
+                threads.emplace_back(checkChunks);
+            }
+
+            // The chunks' misspellings are passed on to the listeners here, in
+            // order, as soon as each chunk (and every one before it) is done.  If
+            // a listener throws an exception, the threads are stopped before it's
+            // allowed to propagate.
+            try
+            {
+                unsigned long firstLineNumber = 1;
+
+                for (std::size_t index = 0; index < chunks.size(); ++index)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock{mutex};
+                        chunkDone.wait(lock, [&]() { return results[index].done; });
+                    }
+
+                    if (results[index].failure)
+                    {
+                        std::rethrow_exception(results[index].failure);
+                    }
+
+                    std::size_t chunkOffset = chunks[index].data() - text.data();
+
+                    for (FoundMisspelling& found : results[index].misspellings)
+                    {
+                        Misspelling misspelling{
+                            found.word, found.line,
+                            firstLineNumber + found.lineNumber - 1, chunkOffset + found.lineOffset,
+                            found.column, found.word.length()};
+
+                        notifyMisspellingFound(misspelling, std::move(found.suggestions));
+                    }
+
+                    firstLineNumber += results[index].newlineCount;
+                    checkedWordCount += results[index].wordCount;
+                    results[index].misspellings = std::vector<FoundMisspelling>{};
+
+                    {
+                        std::lock_guard<std::mutex> lock{mutex};
+                        ++deliveredCount;
+                    }
+
+                    chunkDelivered.notify_all();
+                }
+            }
+            catch (...)
+            {
+                nextChunk = chunks.size();
+
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    deliveredCount = chunks.size();
+                }
+
+                chunkDelivered.notify_all();
+
+                for (std::thread& thread : threads)
+                {
+                    thread.join();
+                }
+
+                throw;
+            }
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+}
+
+
+void SpellChecker::runPipelined(
+    const WordChecker& wordChecker, TextFileReader& reader, unsigned int checkerCount)
+{
+    notifying(
+        [&]()
+        {
+            checkerCount = std::max(checkerCount, 1u);
+
+            typedef std::unique_ptr<PipelineBatch> BatchPointer;
+
+            std::vector<std::unique_ptr<SpscRing<BatchPointer>>> checkerQueues;
+
+            for (unsigned int i = 0; i < checkerCount; ++i)
+            {
+                checkerQueues.push_back(
+                    std::make_unique<SpscRing<BatchPointer>>(PIPELINE_QUEUE_DEPTH));
+            }
+
+            MpscRing<BatchPointer> emitterQueue{PIPELINE_QUEUE_DEPTH * checkerCount};
+
+            // When any stage fails, stopped is set, so the others give up rather
+            // than waiting for it; the first failure is rethrown once they have.
+            std::atomic<bool> stopped{false};
+            std::exception_ptr failure;
+            std::mutex failureMutex;
+
+            auto fail = [&]()
+            {
+                std::lock_guard<std::mutex> lock{failureMutex};
+
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
+
+                stopped = true;
+            };
+
+            // The emitter learns how many batches there are only once the text has
+            // been read to the end.
+            std::atomic<bool> readingDone{false};
+            std::atomic<std::size_t> batchCount{0};
+
+            auto check = [&](unsigned int self)
+            {
+                try
+                {
+                    while (true)
+                    {
+                        BatchPointer batch;
+
+                        SpscRing<BatchPointer>& queue = *checkerQueues[self];
+
+                        if (!keepTrying([&]() { return queue.tryPop(batch); }, stopped) || !batch)
+                        {
+                            return;
+                        }
+
+                        std::string text;
+
+                        for (std::size_t i = 0; i < batch->words.size(); ++i)
+                        {
+                            const PipelineWord& word = batch->words[i];
+                            text.assign(batch->wordText, word.start, word.length);
+
+                            if (!wordChecker.wordExists(text))
+                            {
+                                batch->misspellings.push_back(
+                                    PipelineMisspelling{i, findSuggestions(wordChecker, text)});
+                            }
+                        }
+
+                        if (!keepTrying([&]() { return emitterQueue.tryPush(batch); }, stopped))
+                        {
+                            return;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    fail();
+                }
+            };
+
+            auto emit = [&]()
+            {
+                try
+                {
+                    std::map<std::size_t, BatchPointer> waiting;
+                    std::size_t emittedCount = 0;
+
+                    while (!readingDone || emittedCount < batchCount)
+                    {
+                        BatchPointer batch;
+
+                        if (!keepTrying(
+                                [&]()
+                                {
+                                    return emitterQueue.tryPop(batch)
+                                        || (readingDone && emittedCount == batchCount);
+                                },
+                                stopped))
+                        {
+                            return;
+                        }
+
+                        if (!batch)
+                        {
+                            break;
+                        }
+
+                        std::size_t sequence = batch->sequence;
+                        waiting.emplace(sequence, std::move(batch));
+
+                        for (auto next = waiting.find(emittedCount);
+                             next != waiting.end();
+                             next = waiting.find(emittedCount))
+                        {
+                            PipelineBatch& ready = *next->second;
+                            std::string_view wordText{ready.wordText};
+                            std::string_view lineText{ready.lineText};
+
+                            for (PipelineMisspelling& found : ready.misspellings)
+                            {
+                                const PipelineWord& word = ready.words[found.wordIndex];
+                                const PipelineLine& line = ready.lines[word.lineIndex];
+
+                                Misspelling misspelling{
+                                    wordText.substr(word.start, word.length),
+                                    lineText.substr(line.start, line.length),
+                                    line.lineNumber, line.lineOffset, word.column, word.length};
+
+                                notifyMisspellingFound(misspelling, std::move(found.suggestions));
+                            }
+
+                            waiting.erase(next);
+                            ++emittedCount;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    fail();
+                }
+            };
+
+            std::vector<std::thread> threads;
+
+            for (unsigned int i = 0; i < checkerCount; ++i)
+            {
+                threads.emplace_back(check, i);
+            }
+
+            threads.emplace_back(emit);
+
+            // The text is read on the calling thread, and each batch is given to
+            // the checkers in turn.  An empty batch tells a checker to stop.
+            try
+            {
+                std::size_t sequence = 0;
+
+                auto dispatch = [&](BatchPointer& batch)
+                {
+                    SpscRing<BatchPointer>& queue = *checkerQueues[sequence % checkerCount];
+                    return keepTrying([&]() { return queue.tryPush(batch); }, stopped);
+                };
+
+                BatchPointer batch;
+                unsigned long lastLineNumber = 0;
+
+                while (!reader.noMoreWords() && !stopped)
+                {
+                    if (!batch)
+                    {
+                        batch = std::make_unique<PipelineBatch>();
+                        batch->sequence = sequence;
+                        batch->words.reserve(PIPELINE_BATCH_SIZE);
+                        lastLineNumber = 0;
+                    }
+
+                    if (reader.currentLineNumber() != lastLineNumber)
+                    {
+                        std::string_view line = reader.currentLineView();
+
+                        batch->lines.push_back(PipelineLine{
+                            batch->lineText.length(), line.length(),
+                            reader.currentLineNumber(), reader.currentLineOffset()});
+
+                        batch->lineText.append(line);
+                        lastLineNumber = reader.currentLineNumber();
+                    }
+
+                    const std::string& word = reader.currentWordView();
+
+                    batch->words.push_back(PipelineWord{
+                        batch->wordText.length(), word.length(),
+                        batch->lines.size() - 1, reader.currentColumn()});
+
+                    batch->wordText.append(word);
+
+                    ++checkedWordCount;
+                    reader.advanceToNextWord();
+
+                    if (batch->words.size() == PIPELINE_BATCH_SIZE && dispatch(batch))
+                    {
+                        ++sequence;
+                    }
+                }
+
+                if (batch && dispatch(batch))
+                {
+                    ++sequence;
+                }
+
+                batchCount = sequence;
+                readingDone = true;
+
+                for (unsigned int i = 0; i < checkerCount; ++i)
+                {
+                    BatchPointer noMoreBatches;
+                    keepTrying([&]() { return checkerQueues[i]->tryPush(noMoreBatches); }, stopped);
+                }
+            }
+            catch (...)
+            {
+                fail();
+            }
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            if (failure)
+            {
+                std::rethrow_exception(failure);
+            }
+        });
+}
+
+
+void SpellChecker::runDistinct(const WordChecker& wordChecker, TextFileReader& reader)
+{
+    notifying(
+        [&]()
+        {
+            WordTable words;
+
+            // The suggestions for each misspelled word in the table, by the
+            // word's index; a correctly spelled word has none.
+            std::vector<bool> misspelled;
+            std::vector<std::vector<std::string>> suggestions;
+
+            while (!reader.noMoreWords())
+            {
+                const std::string& word = reader.currentWordView();
+                std::size_t index = words.insert(word);
+
+                if (index == misspelled.size())
+                {
+                    misspelled.push_back(!wordChecker.wordExists(word));
+
+                    suggestions.push_back(
+                        misspelled.back()
+                            ? findSuggestions(wordChecker, word)
+                            : std::vector<std::string>{});
+                }
+
+                if (misspelled[index])
+                {
+                    Misspelling misspelling{
+                        word, reader.currentLineView(),
+                        reader.currentLineNumber(), reader.currentLineOffset(),
+                        reader.currentColumn(), word.length()};
+
+                    notifyMisspellingFound(misspelling, suggestions[index]);
+                }
+
+                ++checkedWordCount;
+                reader.advanceToNextWord();
+            }
+        });
+}
+
+
+void SpellChecker::runSortMerge(
+    const WordChecker& wordChecker, const SortedDictionary& dictionary,
+    const std::string& textFilePath, unsigned int threadCount,
+    bool readAsynchronously, TextEncoding encoding)
+{
+    notifying(
+        [&]()
+        {
+            threadCount = std::max(threadCount, 1u);
+
+            WordTable words;
+
+            {
+                TextFileReader reader{textFilePath, readAsynchronously, encoding};
+
+                for (; !reader.noMoreWords(); reader.advanceToNextWord())
+                {
+                    words.insert(reader.currentWordView());
+                }
+            }
+
+            // Each distinct word is sorted along with its index in the
+            // table, so that what's learned about it can be found again.
+            std::vector<std::pair<std::string_view, std::size_t>> sortedWords;
+            sortedWords.reserve(words.size());
+
+            for (std::size_t index = 0; index < words.size(); ++index)
+            {
+                sortedWords.emplace_back(words.word(index), index);
+            }
+
+            sortInParallel(sortedWords, threadCount);
+
+            std::vector<std::string_view> sortedText;
+            sortedText.reserve(sortedWords.size());
+
+            for (const auto& [word, index] : sortedWords)
+            {
+                sortedText.push_back(word);
+            }
+
+            std::vector<bool> missing = dictionary.findMissing(sortedText);
+
+            std::vector<bool> misspelled(words.size(), false);
+            std::vector<std::size_t> misspelledIndexes;
+
+            for (std::size_t i = 0; i < sortedWords.size(); ++i)
+            {
+                if (missing[i])
+                {
+                    misspelled[sortedWords[i].second] = true;
+                    misspelledIndexes.push_back(sortedWords[i].second);
+                }
+            }
+
+            std::vector<std::vector<std::string>> suggestions(words.size());
+
+            inParallel(
+                std::min<std::size_t>(threadCount, misspelledIndexes.size()),
+                [&](std::size_t self)
+                {
+                    for (std::size_t i = self; i < misspelledIndexes.size(); i += threadCount)
+                    {
+                        std::size_t index = misspelledIndexes[i];
+                        suggestions[index] =
+                            findSuggestions(wordChecker, std::string{words.word(index)});
+                    }
+                });
+
+            TextFileReader reader{textFilePath, readAsynchronously, encoding};
+
+            for (; !reader.noMoreWords(); reader.advanceToNextWord())
+            {
+                const std::string& word = reader.currentWordView();
+                std::size_t index = words.find(word);
+
+                // Every word was seen the first time through, unless the
+                // file was changed in between.
+                if (index == WordTable::NOT_FOUND)
+                {
+                    throw TextChangedException{"Text changed while checking: " + textFilePath};
+                }
+
+                if (misspelled[index])
+                {
+                    Misspelling misspelling{
+                        word, reader.currentLineView(),
+                        reader.currentLineNumber(), reader.currentLineOffset(),
+                        reader.currentColumn(), word.length()};
+
+                    notifyMisspellingFound(misspelling, suggestions[index]);
+                }
+
+                ++checkedWordCount;
+            }
+        });
+}
+
+
+void SpellChecker::setSuggestionCache(std::shared_ptr<SuggestionCache> suggestionCache)
+{
+    this->suggestionCache = suggestionCache;
+}
+
+
+void SpellChecker::setNotificationMode(NotificationMode notificationMode)
+{
+    this->notificationMode = notificationMode;
+}
+
+
+void SpellChecker::setSuggestionLimit(std::size_t suggestionLimit)
+{
+    this->suggestionLimit = suggestionLimit;
+}
+
+
+std::vector<std::string> SpellChecker::findSuggestions(
+    const WordChecker& wordChecker, const std::string& word) const
+{
+    if (suggestionCount == 0)
+    {
+        return std::vector<std::string>{};
+    }
+    else if (!suggestionCache)
+    {
+        return suggestionCount == SpellCheckerListener::ALL_SUGGESTIONS
+            ? wordChecker.findSuggestions(word)
+            : wordChecker.findSuggestions(word, suggestionCount);
+    }
+
+    // The cache holds every suggestion for a word, so it can be shared by
+    // spell checkers whose listeners need different numbers of them.
+    std::vector<std::string> suggestions = suggestionCache->findSuggestions(wordChecker, word);
+
+    if (suggestions.size() > suggestionCount)
     {
-        if (!wordChecker.wordExists(reader.currentWord()))
+        suggestions.resize(suggestionCount);
+    }
+
+    return suggestions;
+}
+
+
+void SpellChecker::notifying(const std::function<void()>& check)
+{
+    // A spell checker without listeners still finds every suggestion, so
+    // that timing it measures all of the work it would otherwise do.
+    listeners = lockObservers();
+
+    std::size_t neededCount = 0;
+
+    for (const std::shared_ptr<SpellCheckerListener>& listener : listeners)
+    {
+        neededCount = std::max(neededCount, listener->maxSuggestions());
+    }
+
+    suggestionCount =
+        listeners.empty() ? suggestionLimit : std::min(neededCount, suggestionLimit);
+    checkedWordCount = 0;
+
+    if (notificationMode != NotificationMode::Immediate)
+    {
+        dispatcher = std::make_unique<MisspellingDispatcher>(
+            [this](const MisspellingBatch& batch) { notifyMisspellingsFound(batch); },
+            NOTIFICATION_BATCH_SIZE,
+            notificationMode == NotificationMode::DedicatedThread);
+    }
+
+    try
+    {
+        check();
+
+        if (dispatcher)
         {
-            notifyMisspellingFound(
-                reader.currentWord(), reader.currentLine(),
-                wordChecker.findSuggestions(reader.currentWord()));
+            dispatcher->finish();
         }
 
-        reader.advanceToNextWord();
+        for (const std::shared_ptr<SpellCheckerListener>& listener : listeners)
+        {
+            listener->wordsChecked(checkedWordCount);
+            listener->checkingFinished();
+        }
+    }
+    catch (...)
+    {
+        dispatcher.reset();
+        listeners.clear();
+        throw;
     }
+
+    dispatcher.reset();
+    listeners.clear();
 }
 
 
 void SpellChecker::notifyMisspellingFound(
-    const std::string& word, const std::string& line,
-    const std::vector<std::string>& suggestions)
+    const Misspelling& misspelling, std::vector<std::string> suggestions)
 {
-    notifyObservers(
-        [&](auto listener)
+    if (dispatcher)
+    {
+        dispatcher->add(misspelling, std::move(suggestions));
+    }
+    else
+    {
+        for (const std::shared_ptr<SpellCheckerListener>& listener : listeners)
         {
-            listener->misspellingFound(word, line, suggestions);
-        });
+            listener->misspellingFound(misspelling, suggestions);
+        }
+    }
 }
 
+
+void SpellChecker::notifyMisspellingsFound(const MisspellingBatch& batch)
+{
+    for (const std::shared_ptr<SpellCheckerListener>& listener : listeners)
+    {
+        listener->misspellingsFound(batch);
+    }
+}
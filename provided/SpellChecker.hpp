@@ -7,26 +7,217 @@
 // WordChecker to determine whether words are spelled correctly,
 // the given TextFileReader to determine which words to check,
 // and notifies any observers whenever misspellings are found.
+//
+// A SuggestionCache can optionally be attached, in which case suggestions
+// for a misspelled word are only computed the first time it's seen (or
+// again after the cache has evicted it).
+//
+// A text file can also be checked in parallel by runParallel(), which
+// splits it into chunks that each end at a newline and checks them on a
+// pool of threads, all sharing the same (read-only) WordChecker.  Each
+// chunk's misspellings are collected, then passed on to the listeners in
+// the order they appear in the text, on the thread that called
+// runParallel(), so listeners see exactly what run() would have shown
+// them.  The threads are kept from getting too far ahead of the
+// listeners, so that only a bounded number of chunks' misspellings are
+// held at once.
+//
+// Alternatively, runPipelined() splits the work of run() into three
+// stages, each on its own thread (or threads), so that slow listeners
+// (such as ones writing output) don't hold up the checking:
+//
+// * The calling thread reads the text, collecting its words (and the
+//   lines they're on) into batches.
+// * A number of checker threads each take every Nth batch, looking up its
+//   words and finding suggestions for the misspelled ones.
+// * An emitter thread puts the checked batches back in order and notifies
+//   the listeners of their misspellings.
+//
+// The stages are connected by bounded, lock-free queues (see SpscRing.hpp
+// and MpscRing.hpp), so a stage that gets too far ahead of the next one
+// waits for it to catch up.
+//
+// Finally, runDistinct() checks each distinct word in a text only once.
+// Natural text repeats a relatively small number of words over and over,
+// so as it reads, it keeps every word it has seen in a WordTable (see
+// WordTable.hpp), along with whether it was misspelled and, if so, its
+// suggestions; later occurrences of the word are reported from there.
+// The listeners are notified of every occurrence, just as they would be
+// by run().
+//
+// For offline jobs on large texts, runSortMerge() goes further, never
+// looking a word up at all.  It reads the text once to collect its
+// distinct words, sorts them (on a number of threads), and merges them
+// with a SortedDictionary (see SortedDictionary.hpp) in one sequential
+// pass to learn which are missing.  Suggestions are then found for only
+// those, again on a number of threads, after which the text is read a
+// second time and the listeners are notified of every occurrence of the
+// misspelled words, as run() would have done.
+//
+// Suggestions are only found for misspellings if a listener needs them,
+// and only as many as the most demanding listener needs (see
+// SpellCheckerListener.hpp), which is checked at the beginning of each
+// run; a spell checker with no listeners at all finds every suggestion.
+// A limit can also be placed on them, no matter what the listeners need.
+//
+// Listeners are normally notified of each misspelling as it's found.
+// For higher throughput, the notification mode can be changed so that
+// misspellings are instead collected into batches and each listener is
+// notified of a whole batch at once (see MisspellingDispatcher.hpp),
+// optionally on a thread dedicated to notifying them.  Either way, the
+// listeners see the misspellings in the same order, and have been told
+// of all of them when the run returns.
 
 #ifndef SPELLCHECKER_HPP
 #define SPELLCHECKER_HPP
 
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
 #include <ics46/observable/Observable.hpp>
+#include "MisspellingDispatcher.hpp"
+#include "SortedDictionary.hpp"
+#include "SuggestionCache.hpp"
 #include "SpellCheckerListener.hpp"
 #include "TextFileReader.hpp"
 #include "WordChecker.hpp"
 
 
 
+enum class NotificationMode
+{
+    // Each misspelling is passed to the listeners as soon as it's found.
+    Immediate,
+
+    // Misspellings are passed to the listeners in batches.
+    Batched,
+
+    // Misspellings are passed to the listeners in batches, on a thread
+    // dedicated to doing so.
+    DedicatedThread
+};
+
+
+
 class SpellChecker : public ics46::observable::Observable<SpellCheckerListener>
 {
 public:
+    // The approximate size of the chunks that runParallel() splits a text
+    // into, and the number of chunks per thread that can be checked ahead
+    // of the ones being passed on to the listeners.
+    static constexpr std::size_t PARALLEL_CHUNK_SIZE = 1024 * 1024;
+    static constexpr unsigned int PARALLEL_CHUNKS_AHEAD = 4;
+
+    // The number of words in each of runPipelined()'s batches, and the
+    // number of batches that can be waiting for each checker thread.
+    static constexpr std::size_t PIPELINE_BATCH_SIZE = 1024;
+    static constexpr std::size_t PIPELINE_QUEUE_DEPTH = 8;
+
+    // The number of misspellings in each batch when they're not passed to
+    // the listeners immediately.
+    static constexpr std::size_t NOTIFICATION_BATCH_SIZE = 256;
+
+
+    // A TextChangedException is thrown by runSortMerge() when the text
+    // turns out to be different the second time it's read.
+    class TextChangedException
+    {
+    public:
+        TextChangedException(const std::string& reason);
+
+        std::string reason() const;
+
+    private:
+        std::string reason_;
+    };
+
+
+public:
+    SpellChecker();
+
     void run(const WordChecker& wordChecker, TextFileReader& reader);
 
+    // runParallel() checks the text in the given file on the given number
+    // of threads.  The file is mapped into memory (see MappedFile.hpp), so
+    // it should be a regular file.
+    void runParallel(
+        const WordChecker& wordChecker, const std::string& textFilePath,
+        unsigned int threadCount, TextEncoding encoding = TextEncoding::Ascii);
+
+    // runPipelined() checks the text read by the reader using the given
+    // number of checker threads.  Unlike runParallel(), it reads the text
+    // sequentially, so it works just as well on streams; the listeners are
+    // notified on a thread of its own, but are never notified by two
+    // threads at once, and have all been notified when it returns.
+    void runPipelined(
+        const WordChecker& wordChecker, TextFileReader& reader, unsigned int checkerCount);
+
+    // runDistinct() checks the text read by the reader, checking each
+    // distinct word (and finding its suggestions) only once.
+    void runDistinct(const WordChecker& wordChecker, TextFileReader& reader);
+
+    // runSortMerge() checks the text in the given file against the
+    // dictionary, sorting its words and finding suggestions on the given
+    // number of threads.  The file is read twice, so it can't be a stream,
+    // and a TextChangedException is thrown if it changes in the meantime.
+    // Both times, it's read the way a TextFileReader constructed with the
+    // given readAsynchronously and encoding would read it.  The
+    // WordChecker is only used to find suggestions.
+    void runSortMerge(
+        const WordChecker& wordChecker, const SortedDictionary& dictionary,
+        const std::string& textFilePath, unsigned int threadCount,
+        bool readAsynchronously = false, TextEncoding encoding = TextEncoding::Ascii);
+
+    // setSuggestionCache() attaches a cache to be used by subsequent runs;
+    // passing nullptr detaches it, so that every misspelling's suggestions
+    // are computed from scratch.
+    void setSuggestionCache(std::shared_ptr<SuggestionCache> suggestionCache);
+
+    // setNotificationMode() changes how listeners are notified during
+    // subsequent runs.
+    void setNotificationMode(NotificationMode notificationMode);
+
+    // setSuggestionLimit() limits the number of suggestions found for each
+    // misspelling during subsequent runs; zero means that none are.
+    void setSuggestionLimit(std::size_t suggestionLimit);
+
+private:
+    std::shared_ptr<SuggestionCache> suggestionCache;
+    NotificationMode notificationMode;
+    std::size_t suggestionLimit;
+
+    // The number of suggestions to find for each misspelling during the
+    // current run, considering both the limit and the listeners' needs.
+    std::size_t suggestionCount;
+
+    // The number of words checked during the current run.
+    unsigned long checkedWordCount;
+
+    // The listeners as they were when the current run began, each kept
+    // alive until it ends, so that they needn't be looked up again for
+    // every misspelling.
+    std::vector<std::shared_ptr<SpellCheckerListener>> listeners;
+
+    // While a run is underway in a mode other than Immediate, this
+    // collects its misspellings.
+    std::unique_ptr<MisspellingDispatcher> dispatcher;
+
 private:
+    std::vector<std::string> findSuggestions(
+        const WordChecker& wordChecker, const std::string& word) const;
+
+    // notifying() calls the given function, which checks a text, with
+    // the dispatcher set up for the current notification mode (and the
+    // number of suggestions to find decided), then
+    // waits for the listeners to be notified of everything it found and
+    // tells them how many words were checked and that checking is finished.
+    void notifying(const std::function<void()>& check);
+
     void notifyMisspellingFound(
-        const std::string& word, const std::string& line,
-        const std::vector<std::string>& suggestions);
+        const Misspelling& misspelling, std::vector<std::string> suggestions);
+
+    void notifyMisspellingsFound(const MisspellingBatch& batch);
 };
 
 
@@ -4,26 +4,84 @@
 // Project #3: Set the Controls for the Heart of the Sun
 //
 // An abstract base class for listeners that are told when spell
-// checkers do interesting things.  At present, there's only one
-// such thing: a notification that a misspelling was found.
+// checkers do interesting things: when a misspelling is found, how many
+// words were checked, and when checking is finished.
+//
+// Spell checkers describe each misspelling with a Misspelling (see
+// Misspelling.hpp), which says where the word was found without copying
+// the line it's on.  Listeners that would rather be given their own
+// copies of the word and the line can derive from
+// CopyingSpellCheckerListener (see CopyingSpellCheckerListener.hpp)
+// instead.
+//
+// Spell checkers can also notify listeners of a batch of misspellings at
+// once (see MisspellingBatch.hpp).  By default, that form calls the
+// Misspelling form for each misspelling in the batch, in order.
+//
+// Once a spell checker has notified its listeners of every misspelling
+// in a text, it tells them how many words it checked altogether, then
+// that it's finished, so that listeners that hold onto output (or
+// anything else) can finish up.
+//
+// Finding suggestions is by far the most expensive part of handling a
+// misspelling, so listeners say how many they need.  A spell checker
+// finds only as many as its most demanding listener needs, and none at
+// all if none of its listeners need any (for example, if they're only
+// counting misspellings).  A listener can therefore be given more
+// suggestions than it asked for, but never fewer than were found.
 
 #ifndef SPELLCHECKERLISTENER_HPP
 #define SPELLCHECKERLISTENER_HPP
 
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <vector>
+#include "Misspelling.hpp"
+#include "MisspellingBatch.hpp"
 
 
 
 class SpellCheckerListener
 {
 public:
+    static constexpr std::size_t ALL_SUGGESTIONS = std::numeric_limits<std::size_t>::max();
+
+public:
+    virtual ~SpellCheckerListener() = default;
+
+
+    // maxSuggestions() returns the number of suggestions the listener
+    // needs for each misspelling, which is zero if it doesn't need any.
+    virtual std::size_t maxSuggestions() const
+    {
+        return ALL_SUGGESTIONS;
+    }
+
+
     virtual void misspellingFound(
-        const std::string& word, const std::string& line,
-        const std::vector<std::string>& suggestions) = 0;
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions) = 0;
+
+
+    virtual void misspellingsFound(const MisspellingBatch& batch)
+    {
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            misspellingFound(batch.misspelling(i), batch.suggestions(i));
+        }
+    }
+
+
+    virtual void wordsChecked(unsigned long wordCount)
+    {
+    }
+
+
+    virtual void checkingFinished()
+    {
+    }
 };
 
 
 
 #endif // SPELLCHECKERLISTENER_HPP
-
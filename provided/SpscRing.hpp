@@ -0,0 +1,123 @@
+// SpscRing.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// An SpscRing is a bounded, lock-free queue connecting exactly one thread
+// that pushes values to exactly one thread that pops them.  The values
+// are kept in a ring of slots whose number is a power of two; the two
+// threads each own one end of the ring (its tail and head, respectively)
+// and only read the other's, so neither ever waits on a lock.  When the
+// ring is full, tryPush() fails, and when it's empty, tryPop() does,
+// leaving it to the caller to decide how to wait.
+
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+
+template <typename T>
+class SpscRing
+{
+public:
+    // The capacity is rounded up to a power of two.
+    explicit SpscRing(std::size_t capacity);
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const;
+
+    // tryPush() moves the value into the ring and returns true, unless the
+    // ring is full, in which case it returns false and leaves the value
+    // alone.  Only the producing thread may call it.
+    bool tryPush(T& value);
+
+    // tryPop() moves the oldest value out of the ring into value and
+    // returns true, unless the ring is empty, in which case it returns
+    // false.  Only the consuming thread may call it.
+    bool tryPop(T& value);
+
+private:
+    std::vector<T> slots;
+    std::size_t mask;
+
+    // The head (the next slot to pop) and tail (the next slot to push)
+    // count upward forever and are masked to find their slots.  They're
+    // kept on separate cache lines, since each is written by a different
+    // thread.
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+};
+
+
+
+namespace spsc_ring_detail
+{
+    inline std::size_t roundUpToPowerOfTwo(std::size_t n)
+    {
+        std::size_t power = 1;
+
+        while (power < n)
+        {
+            power *= 2;
+        }
+
+        return power;
+    }
+}
+
+
+template <typename T>
+SpscRing<T>::SpscRing(std::size_t capacity)
+    : slots(spsc_ring_detail::roundUpToPowerOfTwo(capacity)),
+      mask{slots.size() - 1}, head{0}, tail{0}
+{
+}
+
+
+template <typename T>
+std::size_t SpscRing<T>::capacity() const
+{
+    return slots.size();
+}
+
+
+template <typename T>
+bool SpscRing<T>::tryPush(T& value)
+{
+    std::size_t t = tail.load(std::memory_order_relaxed);
+
+    if (t - head.load(std::memory_order_acquire) == slots.size())
+    {
+        return false;
+    }
+
+    slots[t & mask] = std::move(value);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+
+template <typename T>
+bool SpscRing<T>::tryPop(T& value)
+{
+    std::size_t h = head.load(std::memory_order_relaxed);
+
+    if (h == tail.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    value = std::move(slots[h & mask]);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+
+
+#endif // SPSCRING_HPP
@@ -0,0 +1,117 @@
+// StatsSpellCheckerListener.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include "StatsSpellCheckerListener.hpp"
+
+
+
+StatsSpellCheckerListener::StatsSpellCheckerListener(std::ostream& out, std::size_t topCount)
+    : out{out}, topCount{topCount}, wordCount_{0}, misspellingCount_{0}
+{
+}
+
+
+std::size_t StatsSpellCheckerListener::maxSuggestions() const
+{
+    return 0;
+}
+
+
+void StatsSpellCheckerListener::misspellingFound(
+    const Misspelling& misspelling, const std::vector<std::string>& suggestions)
+{
+    std::size_t index = misspelledWords.insert(misspelling.word);
+
+    if (index == misspelledWordCounts.size())
+    {
+        misspelledWordCounts.push_back(0);
+    }
+
+    ++misspelledWordCounts[index];
+    ++misspellingCount_;
+}
+
+
+void StatsSpellCheckerListener::wordsChecked(unsigned long wordCount)
+{
+    wordCount_ += wordCount;
+}
+
+
+void StatsSpellCheckerListener::checkingFinished()
+{
+    out << "Words checked: " << wordCount_ << std::endl;
+    out << "Misspellings: " << misspellingCount_ << std::endl;
+    out << "Distinct misspelled words: " << distinctMisspellingCount() << std::endl;
+
+    std::vector<std::pair<std::string, unsigned long>> top = mostFrequentMisspellings(topCount);
+
+    if (!top.empty())
+    {
+        out << "Most frequent misspellings:" << std::endl;
+
+        // The counts are right-aligned to the width of the largest one.
+        int width = static_cast<int>(std::to_string(top.front().second).length());
+
+        for (const auto& [word, count] : top)
+        {
+            out << "    " << std::setw(width) << count << "  " << word << std::endl;
+        }
+    }
+}
+
+
+unsigned long StatsSpellCheckerListener::wordCount() const
+{
+    return wordCount_;
+}
+
+
+unsigned long StatsSpellCheckerListener::misspellingCount() const
+{
+    return misspellingCount_;
+}
+
+
+std::size_t StatsSpellCheckerListener::distinctMisspellingCount() const
+{
+    return misspelledWords.size();
+}
+
+
+std::vector<std::pair<std::string, unsigned long>>
+StatsSpellCheckerListener::mostFrequentMisspellings(std::size_t count) const
+{
+    std::vector<std::size_t> indexes(misspelledWords.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+
+    count = std::min(count, indexes.size());
+
+    // Only the ones being returned need to be sorted.
+    std::partial_sort(
+        indexes.begin(), indexes.begin() + count, indexes.end(),
+        [&](std::size_t a, std::size_t b)
+        {
+            if (misspelledWordCounts[a] != misspelledWordCounts[b])
+            {
+                return misspelledWordCounts[a] > misspelledWordCounts[b];
+            }
+
+            return misspelledWords.word(a) < misspelledWords.word(b);
+        });
+
+    std::vector<std::pair<std::string, unsigned long>> mostFrequent;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        mostFrequent.emplace_back(
+            std::string{misspelledWords.word(indexes[i])}, misspelledWordCounts[indexes[i]]);
+    }
+
+    return mostFrequent;
+}
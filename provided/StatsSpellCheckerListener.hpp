@@ -0,0 +1,82 @@
+// StatsSpellCheckerListener.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckerListener that, rather than describing each misspelling,
+// keeps statistics about them and reports them once checking is finished:
+// the number of words checked, the number of misspellings, the number of
+// distinct misspelled words, and the ones that were misspelled most often,
+// such as:
+//
+//     Words checked: 1520
+//     Misspellings: 43
+//     Distinct misspelled words: 17
+//     Most frequent misspellings:
+//         12  TEH
+//          5  RECIEVE
+//
+// Each distinct misspelled word is counted in a WordTable (see
+// WordTable.hpp), so counting one costs about as much as a hash lookup.
+// Since the report doesn't include suggestions, none are asked for.
+//
+// The statistics accumulate across runs, so a listener that's notified
+// by more than one run reports on all of them so far each time one ends.
+
+#ifndef STATSSPELLCHECKERLISTENER_HPP
+#define STATSSPELLCHECKERLISTENER_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SpellCheckerListener.hpp"
+#include "WordTable.hpp"
+
+
+
+class StatsSpellCheckerListener : public SpellCheckerListener
+{
+public:
+    // The number of most frequent misspellings reported by default.
+    static constexpr std::size_t DEFAULT_TOP_COUNT = 10;
+
+public:
+    StatsSpellCheckerListener(std::ostream& out, std::size_t topCount = DEFAULT_TOP_COUNT);
+
+    virtual std::size_t maxSuggestions() const;
+
+    virtual void misspellingFound(
+        const Misspelling& misspelling, const std::vector<std::string>& suggestions);
+
+    virtual void wordsChecked(unsigned long wordCount);
+    virtual void checkingFinished();
+
+    unsigned long wordCount() const;
+    unsigned long misspellingCount() const;
+    std::size_t distinctMisspellingCount() const;
+
+    // mostFrequentMisspellings() returns up to the given number of the
+    // distinct misspelled words, along with how many times each was
+    // misspelled, from most to least often; words misspelled equally
+    // often are in alphabetical order.
+    std::vector<std::pair<std::string, unsigned long>> mostFrequentMisspellings(
+        std::size_t count) const;
+
+private:
+    std::ostream& out;
+    std::size_t topCount;
+
+    unsigned long wordCount_;
+    unsigned long misspellingCount_;
+
+    // The number of times each word in the table was misspelled, by the
+    // word's index.
+    WordTable misspelledWords;
+    std::vector<unsigned long> misspelledWordCounts;
+};
+
+
+
+#endif // STATSSPELLCHECKERLISTENER_HPP
@@ -0,0 +1,100 @@
+// StreamLineSource.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include "StreamLineSource.hpp"
+
+
+
+StreamLineSource::StreamLineSource(
+    int fileDescriptor, bool closeWhenDone, std::size_t chunkSize)
+    : fileDescriptor{fileDescriptor}, closeWhenDone{closeWhenDone},
+      eof{fileDescriptor < 0}, buffer(chunkSize > 0 ? chunkSize : 1),
+      begin{0}, scanned{0}, end{0}
+{
+}
+
+
+StreamLineSource::~StreamLineSource()
+{
+    if (closeWhenDone && fileDescriptor >= 0)
+    {
+        ::close(fileDescriptor);
+    }
+}
+
+
+bool StreamLineSource::nextLine(std::string_view& line)
+{
+    while (true)
+    {
+        const void* newline = std::memchr(buffer.data() + scanned, '\n', end - scanned);
+
+        if (newline != nullptr)
+        {
+            std::size_t lineEnd = static_cast<const char*>(newline) - buffer.data();
+            line = std::string_view{buffer.data() + begin, lineEnd - begin};
+            begin = lineEnd + 1;
+            scanned = begin;
+            return true;
+        }
+
+        scanned = end;
+
+        if (eof)
+        {
+            if (begin == end)
+            {
+                return false;
+            }
+
+            line = std::string_view{buffer.data() + begin, end - begin};
+            begin = end;
+            scanned = end;
+            return true;
+        }
+
+        readChunk();
+    }
+}
+
+
+void StreamLineSource::readChunk()
+{
+    // Carry the partial line to the front of the buffer, then make room
+    // for it to be completed, growing the buffer only if the partial line
+    // already fills it.
+    if (begin > 0)
+    {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        scanned -= begin;
+        begin = 0;
+    }
+
+    if (end == buffer.size())
+    {
+        buffer.resize(buffer.size() * 2);
+    }
+
+    ssize_t bytesRead;
+
+    do
+    {
+        bytesRead = ::read(fileDescriptor, buffer.data() + end, buffer.size() - end);
+    }
+    while (bytesRead < 0 && errno == EINTR);
+
+    if (bytesRead <= 0)
+    {
+        eof = true;
+    }
+    else
+    {
+        end += bytesRead;
+    }
+}
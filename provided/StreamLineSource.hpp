@@ -0,0 +1,66 @@
+// StreamLineSource.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LineSource that produces the lines of text arriving on a file
+// descriptor, such as standard input or a named pipe, which can't be
+// mapped into memory and whose size isn't known in advance.
+//
+// The text is read in large chunks into a buffer.  A line that's cut off
+// by the end of a chunk is carried to the front of the buffer and
+// completed by the next chunk, so a word is never split in two.  The
+// buffer only grows when a single line is longer than it is, so memory use
+// is bounded by the longest line rather than the size of the input.  Each
+// read returns whatever is available, so lines are produced as soon as
+// they arrive rather than when the input ends.
+
+#ifndef STREAMLINESOURCE_HPP
+#define STREAMLINESOURCE_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "LineSource.hpp"
+
+
+
+class StreamLineSource : public LineSource
+{
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    // The descriptor is closed by the destructor only if closeWhenDone is
+    // true; a negative descriptor is treated as an empty input.
+    StreamLineSource(
+        int fileDescriptor, bool closeWhenDone,
+        std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    virtual ~StreamLineSource();
+
+    StreamLineSource(const StreamLineSource&) = delete;
+    StreamLineSource& operator=(const StreamLineSource&) = delete;
+
+    // The line is a view into the buffer, so it's valid only until the
+    // next call to nextLine().
+    virtual bool nextLine(std::string_view& line);
+
+private:
+    int fileDescriptor;
+    bool closeWhenDone;
+    bool eof;
+
+    // The unconsumed text is buffer[begin, end); none of
+    // buffer[begin, scanned) is a newline.
+    std::vector<char> buffer;
+    std::size_t begin;
+    std::size_t scanned;
+    std::size_t end;
+
+private:
+    void readChunk();
+};
+
+
+
+#endif // STREAMLINESOURCE_HPP
@@ -43,7 +43,7 @@ unsigned int hashStringAsProduct(const std::string& word)
 
     for (size_t i = 0; i < word.length(); ++i)
     {
-        hash *= 37;
+        hash *= PRODUCT_HASH_MULTIPLIER;
         hash += static_cast<unsigned int>(word[i]);
     }
     
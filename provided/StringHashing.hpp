@@ -17,6 +17,13 @@ unsigned int hashStringAsSum(const std::string& word);
 unsigned int hashStringAsProduct(const std::string& word);
 
 
+// The multiplier used by hashStringAsProduct().  Since that hash is a
+// polynomial in this multiplier (modulo 2^32), the hash of a string that
+// differs from another by a small edit can be derived from the hashes of
+// the other's prefixes without rehashing the whole string.
+constexpr unsigned int PRODUCT_HASH_MULTIPLIER = 37;
+
+
 
 #endif // STRINGHASHING_HPP
 
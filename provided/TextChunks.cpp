@@ -0,0 +1,32 @@
+// TextChunks.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include "TextChunks.hpp"
+
+
+
+std::vector<std::string_view> splitIntoChunks(std::string_view text, unsigned int count)
+{
+    std::vector<std::string_view> chunks;
+    std::size_t begin = 0;
+
+    for (unsigned int i = 1; i <= count && begin < text.length(); ++i)
+    {
+        std::size_t end = text.length() * i / count;
+
+        if (i < count)
+        {
+            end = std::max(end, begin);
+            std::size_t newline = text.find('\n', end);
+            end = newline == std::string_view::npos ? text.length() : newline + 1;
+        }
+
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+
+    return chunks;
+}
@@ -0,0 +1,25 @@
+// TextChunks.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A function that splits a text held in memory into chunks that can be
+// processed independently, each on its own thread, without any line
+// being split between two of them.
+
+#ifndef TEXTCHUNKS_HPP
+#define TEXTCHUNKS_HPP
+
+#include <string_view>
+#include <vector>
+
+
+
+// splitIntoChunks() splits the text into (at most) the given number of
+// pieces of roughly equal size, each of which ends just after a newline,
+// except possibly the last.
+std::vector<std::string_view> splitIntoChunks(std::string_view text, unsigned int count);
+
+
+
+#endif // TEXTCHUNKS_HPP
@@ -3,82 +3,104 @@
 // ICS 46 Spring 2017
 // Project #3: Set the Controls for the Heart of the Sun
 
-#include <cctype>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "TextFileReader.hpp"
+#include "AsyncLineSource.hpp"
+#include "MappedLineSource.hpp"
+#include "StreamLineSource.hpp"
 
 
-TextFileReader::TextFileReader(const std::string& textFilePath)
-    : textFile{textFilePath}, eof{false}, line{}, lineIndex{0}, word{}
-{
-    advanceToNextWord();
-}
 
-
-bool TextFileReader::noMoreWords() const
+namespace
 {
-    return eof;
-}
-
-
-void TextFileReader::advanceToNextWord()
-{
-    word = "";
-
-    while (!eof)
+    std::unique_ptr<LineSource> makeLineSource(
+        const std::string& textFilePath, bool readAsynchronously)
     {
-        while (lineIndex < line.length() && !std::isalnum(line[lineIndex]))
+        if (textFilePath == TextFileReader::STANDARD_INPUT_PATH)
         {
-            ++lineIndex;                
+            return std::make_unique<StreamLineSource>(STDIN_FILENO, false);
         }
 
-        if (lineIndex >= line.length())
-        {
-            advanceToNextLine();
-            continue;
-        }
+        struct stat status;
 
-        while (lineIndex < line.length() &&
-            (std::isalnum(line[lineIndex]) || line[lineIndex] == '-' || line[lineIndex] == '\''))
+        if (::stat(textFilePath.c_str(), &status) == 0 && !S_ISREG(status.st_mode))
         {
-            word.push_back(std::toupper(line[lineIndex++]));
+            return std::make_unique<StreamLineSource>(
+                ::open(textFilePath.c_str(), O_RDONLY), true);
         }
 
-        if (!std::isalnum(word[word.length() - 1]))
+        if (readAsynchronously)
         {
-            word.pop_back();
+            return std::make_unique<AsyncLineSource>(textFilePath);
         }
 
-        if (word.length() > 0)
-        {
-            return;
-        }
+        return std::make_unique<MappedLineSource>(textFilePath);
     }
 }
 
 
-void TextFileReader::advanceToNextLine()
+
+const std::string TextFileReader::STANDARD_INPUT_PATH = "-";
+
+
+TextFileReader::TextFileReader(
+    const std::string& textFilePath, bool readAsynchronously, TextEncoding encoding)
+    : reader{makeLineSource(textFilePath, readAsynchronously), encoding}
 {
-    if (std::getline(textFile, line))
-    {
-        lineIndex = 0;
-    }
-    else
-    {
-        eof = true;
-        line = "";
-        lineIndex = 0;
-    }
+}
+
+
+bool TextFileReader::noMoreWords() const
+{
+    return reader.noMoreWords();
+}
+
+
+void TextFileReader::advanceToNextWord()
+{
+    reader.advanceToNextWord();
 }
 
 
 std::string TextFileReader::currentLine() const
 {
-    return line;
+    return std::string{reader.currentLine()};
 }
 
 
 std::string TextFileReader::currentWord() const
 {
-    return word;
+    return reader.currentWord();
 }
 
+
+std::string_view TextFileReader::currentLineView() const
+{
+    return reader.currentLine();
+}
+
+
+const std::string& TextFileReader::currentWordView() const
+{
+    return reader.currentWord();
+}
+
+
+unsigned long TextFileReader::currentLineNumber() const
+{
+    return reader.currentLineNumber();
+}
+
+
+std::size_t TextFileReader::currentLineOffset() const
+{
+    return reader.currentLineOffset();
+}
+
+
+std::size_t TextFileReader::currentColumn() const
+{
+    return reader.currentColumn();
+}
@@ -6,19 +6,39 @@
 // Reads an input file and makes it possible to consume it word by word,
 // with spaces and punctuation skipped (except for hyphens or apostrophes
 // within words).
+//
+// The reading itself is done by a TextReader; this class chooses where its
+// lines come from and adapts it to the original interface, in which lines
+// and words are returned as copies.  Callers that don't need their own
+// copies can instead use currentLineView() and currentWordView(), which
+// copy nothing.
+//
+// Regular files are mapped into memory, unless they're to be read
+// asynchronously, in which case they're read ahead in large chunks by an
+// AsyncFileReader (see AsyncFileReader.hpp).  Anything else, such as a
+// named pipe, is streamed in chunks, as is standard input, which is read
+// when the path is STANDARD_INPUT_PATH ("-").
+//
+// The text is ASCII unless it's given as UTF-8, in which case words can
+// contain letters outside of ASCII (see TextReader.hpp).
 
 #ifndef TEXTFILEREADER_HPP
 #define TEXTFILEREADER_HPP
 
-#include <fstream>
 #include <string>
+#include <string_view>
+#include "TextReader.hpp"
 
 
 
 class TextFileReader
 {
 public:
-    TextFileReader(const std::string& textFilePath);
+    static const std::string STANDARD_INPUT_PATH;
+
+    TextFileReader(
+        const std::string& textFilePath, bool readAsynchronously = false,
+        TextEncoding encoding = TextEncoding::Ascii);
 
     bool noMoreWords() const;
     void advanceToNextWord();
@@ -26,21 +46,21 @@ public:
     std::string currentLine() const;
     std::string currentWord() const;
 
-private:
-    std::ifstream textFile;
-
-    bool eof;
+    // These return the current line and word without copying them.  The
+    // line's view stays valid until the reader advances to a word on
+    // another line; the word's is only valid until the reader advances.
+    std::string_view currentLineView() const;
+    const std::string& currentWordView() const;
 
-    std::string line;
-    int lineIndex;
-
-    std::string word;
+    // These describe where the current word is (see TextReader.hpp).
+    unsigned long currentLineNumber() const;
+    std::size_t currentLineOffset() const;
+    std::size_t currentColumn() const;
 
 private:
-    void advanceToNextLine();
+    TextReader reader;
 };
 
 
 
 #endif // TEXTFILEREADER_HPP
-
@@ -0,0 +1,111 @@
+// TextReader.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "TextReader.hpp"
+
+
+
+TextReader::TextReader(std::unique_ptr<LineSource> source, TextEncoding encoding)
+    : source{std::move(source)}, encoding{encoding}, eof{false}, line{}, lineNumber{0}, lineOffset{0},
+      nextToken{0}, word{}, column{0}
+{
+    advanceToNextWord();
+}
+
+
+bool TextReader::noMoreWords() const
+{
+    return eof;
+}
+
+
+void TextReader::advanceToNextWord()
+{
+    word.clear();
+
+    while (!eof)
+    {
+        if (nextToken < tokens.size())
+        {
+            const Token& token = tokens[nextToken++];
+            word.assign(upperLine, token.offset, token.length);
+            column = token.offset;
+            return;
+        }
+
+        advanceToNextLine();
+    }
+}
+
+
+void TextReader::advanceToNextLine()
+{
+    // The previous line was followed by a newline if another line follows.
+    if (lineNumber > 0)
+    {
+        lineOffset += line.length() + 1;
+    }
+
+    if (!source->nextLine(line))
+    {
+        eof = true;
+        line = std::string_view{};
+        tokens.clear();
+        nextToken = 0;
+        return;
+    }
+
+    ++lineNumber;
+    nextToken = 0;
+
+    if (encoding == TextEncoding::Utf8)
+    {
+        tokenizeLineUtf8(line, tokens);
+
+        if (!tokens.empty())
+        {
+            uppercaseLineUtf8(line, upperLine);
+        }
+    }
+    else
+    {
+        tokenizeLine(line, tokens);
+
+        if (!tokens.empty())
+        {
+            uppercaseLine(line, upperLine);
+        }
+    }
+}
+
+
+std::string_view TextReader::currentLine() const
+{
+    return line;
+}
+
+
+const std::string& TextReader::currentWord() const
+{
+    return word;
+}
+
+
+unsigned long TextReader::currentLineNumber() const
+{
+    return lineNumber;
+}
+
+
+std::size_t TextReader::currentLineOffset() const
+{
+    return lineOffset;
+}
+
+
+std::size_t TextReader::currentColumn() const
+{
+    return column;
+}
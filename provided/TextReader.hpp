@@ -0,0 +1,85 @@
+// TextReader.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Reads a text word by word, following the same rules as a TextFileReader,
+// from a LineSource (see LineSource.hpp) that hands it one line at a time,
+// either from a file mapped into memory or from a stream such as standard
+// input.  Lines are never copied, and each line is uppercased into a
+// buffer that's reused from one line to the next, so reading a text
+// allocates (almost) nothing.
+//
+// Each line is split into words all at once by tokenizeLine() (see
+// Tokenizer.hpp), and the words are then handed out one at a time.  When
+// the text is UTF-8, tokenizeLineUtf8() is used instead, so words can
+// contain letters outside of ASCII; lines that are entirely ASCII are
+// handled the same way either way.
+
+#ifndef TEXTREADER_HPP
+#define TEXTREADER_HPP
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LineSource.hpp"
+#include "Normalization.hpp"
+#include "Tokenizer.hpp"
+
+
+
+class TextReader
+{
+public:
+    TextReader(
+        std::unique_ptr<LineSource> source, TextEncoding encoding = TextEncoding::Ascii);
+
+    bool noMoreWords() const;
+    void advanceToNextWord();
+
+    // currentLine() returns the line containing the current word, without
+    // its newline.  The view remains valid at least until the reader
+    // advances to a word on another line.
+    std::string_view currentLine() const;
+
+    // currentWord() returns the current word, uppercased.  The reference
+    // remains valid only until the reader advances to the next word.
+    const std::string& currentWord() const;
+
+    // currentLineNumber() returns the number of the current line, counting
+    // from 1, and currentLineOffset() returns the byte offset of its
+    // beginning within the text.
+    unsigned long currentLineNumber() const;
+    std::size_t currentLineOffset() const;
+
+    // currentColumn() returns the byte offset of the current word within
+    // the current line.
+    std::size_t currentColumn() const;
+
+private:
+    std::unique_ptr<LineSource> source;
+    TextEncoding encoding;
+
+    bool eof;
+
+    std::string_view line;
+    unsigned long lineNumber;
+    std::size_t lineOffset;
+
+    // The words in the current line, the index of the next one to be
+    // handed out, and an uppercased copy of the line to take them from.
+    std::vector<Token> tokens;
+    std::size_t nextToken;
+    std::string upperLine;
+
+    std::string word;
+    std::size_t column;
+
+private:
+    void advanceToNextLine();
+};
+
+
+
+#endif // TEXTREADER_HPP
@@ -0,0 +1,301 @@
+// Tokenizer.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <cstdint>
+#include "Tokenizer.hpp"
+#include "Normalization.hpp"
+#include "SimdSupport.hpp"
+
+
+
+namespace
+{
+    // The bytes of a line are classified into two bitmasks, stored 64 bytes
+    // to a word: "starts" has a bit set for each letter or digit (which can
+    // begin a word), while "wordChars" has a bit set for each character
+    // that can appear in a word.  Bits beyond the end of the line are clear.
+    typedef void (*ClassifyFunction)(
+        const char* text, std::size_t length,
+        std::uint64_t* starts, std::uint64_t* wordChars);
+
+
+    void classifyScalar(
+        const char* text, std::size_t length,
+        std::uint64_t* starts, std::uint64_t* wordChars)
+    {
+        for (std::size_t block = 0; block * 64 < length; ++block)
+        {
+            std::uint64_t s = 0;
+            std::uint64_t w = 0;
+
+            for (std::size_t i = block * 64; i < length && i < block * 64 + 64; ++i)
+            {
+                std::uint64_t bit = std::uint64_t{1} << (i % 64);
+
+                if (isWordStart(text[i]))
+                {
+                    s |= bit;
+                }
+
+                if (isWordPart(text[i]))
+                {
+                    w |= bit;
+                }
+            }
+
+            starts[block] = s;
+            wordChars[block] = w;
+        }
+    }
+
+
+#ifdef SIMD_X86
+
+    void classifySSE2(
+        const char* text, std::size_t length,
+        std::uint64_t* starts, std::uint64_t* wordChars)
+    {
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i lowerA = _mm_set1_epi8('a');
+        const __m128i twentyFive = _mm_set1_epi8(25);
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i hyphen = _mm_set1_epi8('-');
+        const __m128i apostrophe = _mm_set1_epi8('\'');
+
+        std::size_t block = 0;
+
+        for (; block * 64 + 64 <= length; ++block)
+        {
+            std::uint64_t s = 0;
+            std::uint64_t w = 0;
+
+            for (unsigned int part = 0; part < 4; ++part)
+            {
+                __m128i x = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(text + block * 64 + part * 16));
+
+                __m128i digit = lessOrEqual(_mm_sub_epi8(x, zero), nine);
+                __m128i letter = lessOrEqual(
+                    _mm_sub_epi8(_mm_or_si128(x, caseBit), lowerA), twentyFive);
+                __m128i start = _mm_or_si128(digit, letter);
+                __m128i wordChar = _mm_or_si128(
+                    start,
+                    _mm_or_si128(_mm_cmpeq_epi8(x, hyphen), _mm_cmpeq_epi8(x, apostrophe)));
+
+                s |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(start))) << (part * 16);
+                w |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(wordChar))) << (part * 16);
+            }
+
+            starts[block] = s;
+            wordChars[block] = w;
+        }
+
+        classifyScalar(
+            text + block * 64, length - block * 64, starts + block, wordChars + block);
+    }
+
+
+    __attribute__((target("avx2")))
+    void classifyAVX2(
+        const char* text, std::size_t length,
+        std::uint64_t* starts, std::uint64_t* wordChars)
+    {
+        const __m256i zero = _mm256_set1_epi8('0');
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i lowerA = _mm256_set1_epi8('a');
+        const __m256i twentyFive = _mm256_set1_epi8(25);
+        const __m256i caseBit = _mm256_set1_epi8(0x20);
+        const __m256i hyphen = _mm256_set1_epi8('-');
+        const __m256i apostrophe = _mm256_set1_epi8('\'');
+
+        std::size_t block = 0;
+
+        for (; block * 64 + 64 <= length; ++block)
+        {
+            std::uint64_t s = 0;
+            std::uint64_t w = 0;
+
+            for (unsigned int part = 0; part < 2; ++part)
+            {
+                __m256i x = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(text + block * 64 + part * 32));
+
+                __m256i digit = lessOrEqual256(_mm256_sub_epi8(x, zero), nine);
+                __m256i letter = lessOrEqual256(
+                    _mm256_sub_epi8(_mm256_or_si256(x, caseBit), lowerA), twentyFive);
+                __m256i start = _mm256_or_si256(digit, letter);
+                __m256i wordChar = _mm256_or_si256(
+                    start,
+                    _mm256_or_si256(
+                        _mm256_cmpeq_epi8(x, hyphen), _mm256_cmpeq_epi8(x, apostrophe)));
+
+                s |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(start))) << (part * 32);
+                w |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(wordChar))) << (part * 32);
+            }
+
+            starts[block] = s;
+            wordChars[block] = w;
+        }
+
+        classifyScalar(
+            text + block * 64, length - block * 64, starts + block, wordChars + block);
+    }
+
+
+#endif // SIMD_X86
+
+
+    ClassifyFunction chooseClassify()
+    {
+#ifdef SIMD_X86
+        return hasAVX2() ? classifyAVX2 : classifySSE2;
+#else
+        return classifyScalar;
+#endif
+    }
+
+
+    // isCharacterStart() returns true if the character, which begins with
+    // the given byte and encodes the given code point, can begin a word.
+    bool isCharacterStart(char first, char32_t codePoint)
+    {
+        return codePoint < 0x80 ? isWordStart(first) : isNonAsciiLetter(codePoint);
+    }
+
+
+    // nextSetBit() returns the position of the first set bit at or after
+    // the given position, or length if there isn't one.
+    std::size_t nextSetBit(
+        const std::uint64_t* masks, std::size_t position, std::size_t length, bool invert)
+    {
+        std::size_t block = position / 64;
+        std::size_t blockCount = (length + 63) / 64;
+
+        if (block >= blockCount)
+        {
+            return length;
+        }
+
+        std::uint64_t bits =
+            (invert ? ~masks[block] : masks[block]) & (~std::uint64_t{0} << (position % 64));
+
+        while (bits == 0)
+        {
+            if (++block >= blockCount)
+            {
+                return length;
+            }
+
+            bits = invert ? ~masks[block] : masks[block];
+        }
+
+        std::size_t found = block * 64 + __builtin_ctzll(bits);
+        return found < length ? found : length;
+    }
+}
+
+
+
+void tokenizeLine(std::string_view line, std::vector<Token>& tokens)
+{
+    // The masks are kept from one call to the next, so that tokenizing a
+    // file doesn't allocate for every line.
+    thread_local std::vector<std::uint64_t> starts;
+    thread_local std::vector<std::uint64_t> wordChars;
+
+    static const ClassifyFunction classify = chooseClassify();
+
+    tokens.clear();
+
+    std::size_t blockCount = (line.length() + 63) / 64;
+
+    if (starts.size() < blockCount)
+    {
+        starts.resize(blockCount);
+        wordChars.resize(blockCount);
+    }
+
+    classify(line.data(), line.length(), starts.data(), wordChars.data());
+
+    std::size_t position = 0;
+
+    while (true)
+    {
+        std::size_t start = nextSetBit(starts.data(), position, line.length(), false);
+
+        if (start == line.length())
+        {
+            break;
+        }
+
+        std::size_t end = nextSetBit(wordChars.data(), start, line.length(), true);
+        std::size_t last = end - 1;
+
+        // A word can't end with a hyphen or apostrophe, though only one
+        // of them is trimmed.
+        bool trimmed = (starts[last / 64] & (std::uint64_t{1} << (last % 64))) == 0;
+
+        tokens.push_back(Token{start, end - start - (trimmed ? 1 : 0)});
+        position = end;
+    }
+}
+
+
+void tokenizeLineUtf8(std::string_view line, std::vector<Token>& tokens)
+{
+    if (!containsNonAscii(line))
+    {
+        tokenizeLine(line, tokens);
+        return;
+    }
+
+    tokens.clear();
+
+    std::size_t position = 0;
+
+    while (position < line.length())
+    {
+        char32_t codePoint;
+        std::size_t length;
+
+        bool valid = decodeUtf8(line, position, codePoint, length);
+
+        if (!valid || !isCharacterStart(line[position], codePoint))
+        {
+            position += length;
+            continue;
+        }
+
+        std::size_t start = position;
+        std::size_t lastLength = length;
+        position += length;
+
+        while (position < line.length()
+            && decodeUtf8(line, position, codePoint, length)
+            && (isWordPart(line[position]) || isCharacterStart(line[position], codePoint)))
+        {
+            lastLength = length;
+            position += length;
+        }
+
+        bool trimmed = lastLength == 1 && !isWordStart(line[position - 1]);
+        tokens.push_back(Token{start, position - start - (trimmed ? 1 : 0)});
+    }
+}
+
+
+void uppercaseLine(std::string_view line, std::string& upper)
+{
+    upper.resize(line.length());
+    uppercaseAscii(line.data(), line.length(), &upper[0]);
+}
+
+
+void uppercaseLineUtf8(std::string_view line, std::string& upper)
+{
+    upper.resize(line.length());
+    uppercaseUtf8(line.data(), line.length(), &upper[0]);
+}
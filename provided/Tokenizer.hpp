@@ -0,0 +1,63 @@
+// Tokenizer.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Functions that split a line of text into words, following the rules
+// described in TextFileReader.hpp (and classifying characters as
+// Normalization.hpp does):
+//
+// * A word begins with a letter or digit.
+// * A word continues through letters, digits, hyphens, and apostrophes.
+// * If a word ends with a hyphen or apostrophe, that one character is
+//   dropped from the end of it.
+//
+// Rather than classifying one byte at a time, the bytes of the line are
+// classified in blocks using SIMD instructions (AVX2 when the processor
+// supports it, SSE2 otherwise), producing bitmasks from which the words'
+// boundaries are found with bit scans.  A scalar implementation is used
+// on processors without either.
+
+#ifndef TOKENIZER_HPP
+#define TOKENIZER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+// A Token describes where a word is within a line.
+struct Token
+{
+    std::size_t offset;
+    std::size_t length;
+};
+
+
+// tokenizeLine() replaces the contents of tokens with the words found in
+// the given line, in the order they appear.
+void tokenizeLine(std::string_view line, std::vector<Token>& tokens);
+
+
+// tokenizeLineUtf8() is like tokenizeLine(), except that the line is
+// treated as UTF-8, so that a multibyte sequence encoding a letter is part
+// of a word instead of separating two.  Lines that are entirely ASCII are
+// tokenized by tokenizeLine().
+void tokenizeLineUtf8(std::string_view line, std::vector<Token>& tokens);
+
+
+// uppercaseLine() replaces the contents of upper with a copy of line in
+// which the ASCII letters have been made uppercase.
+void uppercaseLine(std::string_view line, std::string& upper);
+
+
+// uppercaseLineUtf8() is like uppercaseLine(), except that the line is
+// treated as UTF-8, so that letters outside of ASCII are made uppercase,
+// too.  The words' offsets and lengths are the same in both copies.
+void uppercaseLineUtf8(std::string_view line, std::string& upper);
+
+
+
+#endif // TOKENIZER_HPP
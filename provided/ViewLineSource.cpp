@@ -0,0 +1,37 @@
+// ViewLineSource.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "ViewLineSource.hpp"
+
+
+
+ViewLineSource::ViewLineSource(std::string_view text)
+    : remaining{text}
+{
+}
+
+
+bool ViewLineSource::nextLine(std::string_view& line)
+{
+    if (remaining.empty())
+    {
+        return false;
+    }
+
+    std::size_t newline = remaining.find('\n');
+
+    if (newline == std::string_view::npos)
+    {
+        line = remaining;
+        remaining = std::string_view{};
+    }
+    else
+    {
+        line = remaining.substr(0, newline);
+        remaining = remaining.substr(newline + 1);
+    }
+
+    return true;
+}
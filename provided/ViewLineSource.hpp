@@ -0,0 +1,33 @@
+// ViewLineSource.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LineSource that produces the lines of a text that's already in memory,
+// such as a file mapped by a MappedFile (see MappedFile.hpp) or a chunk
+// of one.  The lines it produces are views into the text, so they remain
+// valid for as long as the text does; the ViewLineSource doesn't own it.
+
+#ifndef VIEWLINESOURCE_HPP
+#define VIEWLINESOURCE_HPP
+
+#include <string_view>
+#include "LineSource.hpp"
+
+
+
+class ViewLineSource : public LineSource
+{
+public:
+    ViewLineSource(std::string_view text);
+
+    virtual bool nextLine(std::string_view& line);
+
+private:
+    // The part of the text that follows the most recent line.
+    std::string_view remaining;
+};
+
+
+
+#endif // VIEWLINESOURCE_HPP
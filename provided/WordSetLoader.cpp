@@ -4,31 +4,278 @@
 // Project #3: Set the Controls for the Heart of the Sun
 
 #include <algorithm>
-#include <cctype>
-#include <fstream>
+#include <string_view>
+#include <thread>
 #include "WordSetLoader.hpp"
+#include "AsyncLineSource.hpp"
+#include "CompiledSet.hpp"
+#include "EmbeddedSet.hpp"
+#include "MappedFile.hpp"
+#include "Normalization.hpp"
+#include "TextChunks.hpp"
 
 
 
+namespace
+{
+    // readChunk() adds the words in the chunk (one per line) to words.
+    // Chunks that are entirely ASCII are read as ASCII, even if they were
+    // to be read as UTF-8, since there's no difference.
+    void readChunk(
+        std::string_view chunk, TextEncoding encoding, std::vector<std::string>& words)
+    {
+        if (encoding == TextEncoding::Utf8 && !containsNonAscii(chunk))
+        {
+            encoding = TextEncoding::Ascii;
+        }
+
+        std::size_t begin = 0;
+
+        while (begin < chunk.length())
+        {
+            std::size_t newline = chunk.find('\n', begin);
+            std::size_t end = newline == std::string_view::npos ? chunk.length() : newline;
+
+            words.push_back(normalizeWord(chunk.substr(begin, end - begin), encoding));
+            begin = end + 1;
+        }
+    }
+}
+
+
+
+WordSetLoader::FileException::FileException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+std::string WordSetLoader::FileException::reason() const
+{
+    return reason_;
+}
+
+
+
+WordSetLoader::WordSetLoader(bool readAsynchronously, TextEncoding encoding)
+    : readAsynchronously{readAsynchronously}, encoding{encoding}
+{
+}
+
+
 void WordSetLoader::load(const std::string& wordFilePath, Set<std::string>& wordSet)
 {
-    std::ifstream wordFile{wordFilePath};
+    load(wordFilePath, wordSet, nullptr);
+}
+
+
+void WordSetLoader::load(
+    const std::string& wordFilePath, Set<std::string>& wordSet, WordPrefilter& prefilter)
+{
+    load(wordFilePath, wordSet, &prefilter);
+}
+
+
+std::vector<std::string> WordSetLoader::loadedWords(
+    const std::string& wordFilePath, const Set<std::string>& wordSet)
+{
+    std::vector<std::string> words;
+
+    if (dynamic_cast<const EmbeddedSet*>(&wordSet) != nullptr)
+    {
+        for (unsigned int i = 0; i < EmbeddedSet::embeddedSize(); ++i)
+        {
+            words.emplace_back(EmbeddedSet::embeddedWord(i));
+        }
+
+        return words;
+    }
+
+    const CompiledSet* compiledSet = dynamic_cast<const CompiledSet*>(&wordSet);
+
+    if (compiledSet != nullptr)
+    {
+        for (unsigned int i = 0; i < compiledSet->size(); ++i)
+        {
+            words.emplace_back(compiledSet->word(i));
+        }
+
+        return words;
+    }
+
+    return readWords(wordFilePath);
+}
+
+
+std::vector<std::string> WordSetLoader::alphabet() const
+{
+    std::vector<std::string> letters;
+
+    for (char32_t letter : nonAsciiLetters)
+    {
+        letters.push_back(encodeUtf8(letter));
+    }
+
+    return letters;
+}
+
+
+void WordSetLoader::load(
+    const std::string& wordFilePath, Set<std::string>& wordSet, WordPrefilter* prefilter)
+{
+    // Only the words of the sets that hold their words already need to be
+    // visited afterward, and only if there's something to collect.
+    bool visitWords = prefilter != nullptr || encoding == TextEncoding::Utf8;
+
+    if (dynamic_cast<EmbeddedSet*>(&wordSet) != nullptr)
+    {
+        for (unsigned int i = 0; visitWords && i < EmbeddedSet::embeddedSize(); ++i)
+        {
+            addLoadedWord(EmbeddedSet::embeddedWord(i), prefilter);
+        }
 
-    std::string word;
+        return;
+    }
+
+    CompiledSet* compiledSet = dynamic_cast<CompiledSet*>(&wordSet);
+
+    if (compiledSet != nullptr && CompiledSet::isCompiled(wordFilePath))
+    {
+        compiledSet->open(wordFilePath);
+
+        for (unsigned int i = 0; visitWords && i < compiledSet->size(); ++i)
+        {
+            addLoadedWord(compiledSet->word(i), prefilter);
+        }
+
+        return;
+    }
+
+    std::vector<std::string> words = readWords(wordFilePath);
+    wordSet.addAll(words.data(), words.size());
+
+    for (unsigned int i = 0; visitWords && i < words.size(); ++i)
+    {
+        addLoadedWord(words[i], prefilter);
+    }
+}
+
+
+void WordSetLoader::addLoadedWord(std::string_view word, WordPrefilter* prefilter)
+{
+    if (prefilter != nullptr)
+    {
+        prefilter->add(std::string{word});
+    }
 
-    while (std::getline(wordFile, word))
+    if (encoding == TextEncoding::Utf8 && containsNonAscii(word))
     {
-        std::transform(
-            word.begin(), word.end(), word.begin(),
-            [](auto c) { return std::toupper(c); });
+        std::size_t position = 0;
+
+        while (position < word.length())
+        {
+            char32_t codePoint;
+            std::size_t length;
 
-        word.erase(
-            std::remove_if(
-                word.begin(), word.end(),
-                [](auto c) { return c == '\r' || c == '\n'; }),
-            word.end());
+            if (decodeUtf8(word, position, codePoint, length) && isNonAsciiLetter(codePoint))
+            {
+                nonAsciiLetters.insert(codePoint);
+            }
 
-        wordSet.add(word);
+            position += length;
+        }
     }
 }
 
+
+std::vector<std::string> WordSetLoader::readWords(const std::string& wordFilePath)
+{
+    if (CompiledSet::isCompiled(wordFilePath))
+    {
+        CompiledSet compiledSet;
+        compiledSet.open(wordFilePath);
+
+        std::vector<std::string> words;
+        words.reserve(compiledSet.size());
+
+        for (unsigned int i = 0; i < compiledSet.size(); ++i)
+        {
+            words.emplace_back(compiledSet.word(i));
+        }
+
+        return words;
+    }
+
+    if (readAsynchronously)
+    {
+        AsyncLineSource source{wordFilePath};
+
+        if (!source.isOpen())
+        {
+            throw FileException{"Cannot open file: " + wordFilePath};
+        }
+
+        std::vector<std::string> words;
+        std::string_view line;
+
+        while (source.nextLine(line))
+        {
+            words.push_back(normalizeWord(line, encoding));
+        }
+
+        return words;
+    }
+
+    MappedFile file{wordFilePath};
+
+    if (!file.isOpen())
+    {
+        throw FileException{"Cannot open file: " + wordFilePath};
+    }
+
+    std::string_view contents = file.contents();
+
+    unsigned int threadCount = std::max(
+        std::min<std::size_t>(
+            std::thread::hardware_concurrency(), contents.length() / PARALLEL_READ_MINIMUM),
+        std::size_t{1});
+
+    std::vector<std::string_view> chunks = splitIntoChunks(contents, threadCount);
+    std::vector<std::vector<std::string>> chunkWords(chunks.size());
+
+    if (chunks.size() == 1)
+    {
+        readChunk(chunks[0], encoding, chunkWords[0]);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            threads.emplace_back(readChunk, chunks[i], encoding, std::ref(chunkWords[i]));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    if (chunkWords.size() == 1)
+    {
+        return std::move(chunkWords[0]);
+    }
+
+    std::vector<std::string> words;
+
+    for (std::vector<std::string>& someWords : chunkWords)
+    {
+        words.insert(
+            words.end(),
+            std::make_move_iterator(someWords.begin()),
+            std::make_move_iterator(someWords.end()));
+    }
+
+    return words;
+}
@@ -5,22 +5,106 @@
 //
 // A class that loads a word set from a file containing one word on each
 // line.  The words are then added to the given Set<std::string>.
+//
+// The file is mapped into memory (see MappedFile.hpp) and split into
+// chunks that each end at a newline, which are made uppercase in
+// parallel, each on its own thread.  The words are then handed to the set
+// all at once, via addAll(), so that sets that can add them in bulk can
+// do so.
+//
+// The file can instead be a compiled dictionary (see CompiledSet.hpp), in
+// which case its words are read from it without any parsing, and a
+// CompiledSet that loads it simply uses it in place.  A FormatException
+// is thrown if a compiled dictionary is damaged, and a FileException if
+// the word file can't be opened at all.
+//
+// An EmbeddedSet (see EmbeddedSet.hpp) already holds its words, so the
+// word file isn't read when loading one.
+//
+// Alternatively, the file can be read asynchronously by an AsyncFileReader
+// (see AsyncFileReader.hpp), in which case its words are made uppercase
+// as each chunk arrives, while the following chunks are being read.
+//
+// Words are read as ASCII unless they're to be read as UTF-8, in which
+// case the letters outside of ASCII are made uppercase, too (see
+// Normalization.hpp), and the loader collects the dictionary's alphabet,
+// so that a WordChecker can suggest spellings that use those letters.
 
 #ifndef WORDSETLOADER_HPP
 #define WORDSETLOADER_HPP
 
+#include <set>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "Normalization.hpp"
 #include "Set.hpp"
+#include "WordPrefilter.hpp"
 
 
 
 class WordSetLoader
 {
 public:
+    // The number of bytes of the file that each thread is given to read;
+    // smaller files are read without starting any threads.
+    static constexpr unsigned int PARALLEL_READ_MINIMUM = 256 * 1024;
+
+
+    class FileException
+    {
+    public:
+        FileException(const std::string& reason);
+
+        std::string reason() const;
+
+    private:
+        std::string reason_;
+    };
+
+
+public:
+
+    WordSetLoader(
+        bool readAsynchronously = false, TextEncoding encoding = TextEncoding::Ascii);
+
     void load(const std::string& wordFilePath, Set<std::string>& wordSet);
+
+    // This version of load() also adds each word to the given prefilter.
+    void load(
+        const std::string& wordFilePath, Set<std::string>& wordSet,
+        WordPrefilter& prefilter);
+
+    // readWords() returns the words in the given file, in the order they
+    // appear, made uppercase and with any carriage returns removed.
+    std::vector<std::string> readWords(const std::string& wordFilePath);
+
+    // loadedWords() returns the words held by a set that was loaded from
+    // the given file: the embedded dictionary's for an EmbeddedSet, the
+    // compiled dictionary's for a CompiledSet, or otherwise the words in
+    // the file, as they were given to the set.
+    std::vector<std::string> loadedWords(
+        const std::string& wordFilePath, const Set<std::string>& wordSet);
+
+    // alphabet() returns the letters outside of ASCII that appear in the
+    // words loaded so far, each encoded as UTF-8, in order by code point.
+    // They're only collected when the words are read as UTF-8.
+    std::vector<std::string> alphabet() const;
+
+private:
+    bool readAsynchronously;
+    TextEncoding encoding;
+    std::set<char32_t> nonAsciiLetters;
+
+    void load(
+        const std::string& wordFilePath, Set<std::string>& wordSet,
+        WordPrefilter* prefilter);
+
+    // addLoadedWord() adds a word that's been loaded to the prefilter (if
+    // there is one) and its letters to the alphabet.
+    void addLoadedWord(std::string_view word, WordPrefilter* prefilter);
 };
 
 
 
 #endif // WORDSETLOADER_HPP
-
@@ -0,0 +1,73 @@
+// WordSetTypes.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "WordSetTypes.hpp"
+#include "AVLSet.hpp"
+#include "BSTSet.hpp"
+#include "CompiledSet.hpp"
+#include "EmbeddedSet.hpp"
+#include "EmptySet.hpp"
+#include "HashSet.hpp"
+#include "ListSet.hpp"
+#include "SkipListSet.hpp"
+#include "StringHashing.hpp"
+
+
+
+std::vector<std::string> wordSetTypes()
+{
+    return std::vector<std::string>{
+        "AVL", "BST", "COMPILED", "EMBEDDED", "EMPTY",
+        "HASH PRODUCT", "HASH SUM", "HASH ZERO", "LIST", "SKIPLIST"};
+}
+
+
+std::unique_ptr<Set<std::string>> makeWordSet(const std::string& setType)
+{
+    if (setType == "AVL")
+    {
+        return std::make_unique<AVLSet<std::string>>();
+    }
+    else if (setType == "BST")
+    {
+        return std::make_unique<BSTSet<std::string>>();
+    }
+    else if (setType == "COMPILED")
+    {
+        return std::make_unique<CompiledSet>();
+    }
+    else if (setType == "EMBEDDED")
+    {
+        return std::make_unique<EmbeddedSet>();
+    }
+    else if (setType == "EMPTY")
+    {
+        return std::make_unique<EmptySet<std::string>>();
+    }
+    else if (setType == "HASH ZERO")
+    {
+        return std::make_unique<HashSet<std::string>>(hashStringAsZero);
+    }
+    else if (setType == "HASH SUM")
+    {
+        return std::make_unique<HashSet<std::string>>(hashStringAsSum);
+    }
+    else if (setType == "HASH PRODUCT")
+    {
+        return std::make_unique<HashSet<std::string>>(hashStringAsProduct);
+    }
+    else if (setType == "LIST")
+    {
+        return std::make_unique<ListSet<std::string>>();
+    }
+    else if (setType == "SKIPLIST")
+    {
+        return std::make_unique<SkipListSet<std::string>>();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
@@ -0,0 +1,31 @@
+// WordSetTypes.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// The kinds of word sets that can be chosen by name, such as "AVL" or
+// "HASH PRODUCT", both by the shell and by the benchmarks, so that they
+// always offer the same choices.
+
+#ifndef WORDSETTYPES_HPP
+#define WORDSETTYPES_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Set.hpp"
+
+
+
+// wordSetTypes() returns the name of every kind of word set that
+// makeWordSet() can make, in alphabetical order.
+std::vector<std::string> wordSetTypes();
+
+
+// makeWordSet() returns a new, empty word set of the named kind, or
+// nullptr if there's no kind of word set with that name.
+std::unique_ptr<Set<std::string>> makeWordSet(const std::string& setType);
+
+
+
+#endif // WORDSETTYPES_HPP
@@ -0,0 +1,146 @@
+// WordTable.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include "WordTable.hpp"
+
+
+
+namespace
+{
+    constexpr std::size_t INITIAL_SLOT_COUNT = 64;
+
+
+    // hashWord() is FNV-1a, whose bits are then mixed (as in MurmurHash3's
+    // finalizer), since only the low ones are used to choose a slot.
+    std::uint32_t hashWord(std::string_view word)
+    {
+        std::uint32_t hash = 2166136261u;
+
+        for (char c : word)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+
+        return hash;
+    }
+}
+
+
+
+WordTable::WordTable()
+    : slots(INITIAL_SLOT_COUNT, 0), mask{INITIAL_SLOT_COUNT - 1}
+{
+}
+
+
+std::size_t WordTable::insert(std::string_view word)
+{
+    std::uint32_t hash = hashWord(word);
+    std::size_t slot = findSlot(word, hash);
+
+    if (slots[slot] != 0)
+    {
+        return slots[slot] - 1;
+    }
+
+    std::size_t index = entries.size();
+
+    entries.push_back(Entry{text.length(), static_cast<std::uint32_t>(word.length()), hash});
+    text.append(word);
+    slots[slot] = static_cast<std::uint32_t>(index + 1);
+
+    if (entries.size() * 2 > slots.size())
+    {
+        grow();
+    }
+
+    return index;
+}
+
+
+std::size_t WordTable::find(std::string_view word) const
+{
+    std::size_t slot = findSlot(word, hashWord(word));
+    return slots[slot] != 0 ? slots[slot] - 1 : NOT_FOUND;
+}
+
+
+std::string_view WordTable::word(std::size_t index) const
+{
+    const Entry& entry = entries[index];
+    return std::string_view{text}.substr(entry.start, entry.length);
+}
+
+
+std::size_t WordTable::size() const
+{
+    return entries.size();
+}
+
+
+bool WordTable::empty() const
+{
+    return entries.empty();
+}
+
+
+void WordTable::clear()
+{
+    text.clear();
+    entries.clear();
+    std::fill(slots.begin(), slots.end(), 0);
+}
+
+
+// findSlot() returns the slot that refers to the word, or the empty slot
+// where it belongs if it's not in the table.
+std::size_t WordTable::findSlot(std::string_view word, std::uint32_t hash) const
+{
+    std::size_t slot = hash & mask;
+
+    while (slots[slot] != 0)
+    {
+        const Entry& entry = entries[slots[slot] - 1];
+
+        if (entry.hash == hash && entry.length == word.length()
+            && text.compare(entry.start, entry.length, word) == 0)
+        {
+            break;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+
+void WordTable::grow()
+{
+    std::vector<std::uint32_t> newSlots(slots.size() * 2, 0);
+    std::size_t newMask = newSlots.size() - 1;
+
+    for (std::size_t index = 0; index < entries.size(); ++index)
+    {
+        std::size_t slot = entries[index].hash & newMask;
+
+        while (newSlots[slot] != 0)
+        {
+            slot = (slot + 1) & newMask;
+        }
+
+        newSlots[slot] = static_cast<std::uint32_t>(index + 1);
+    }
+
+    slots.swap(newSlots);
+    mask = newMask;
+}
@@ -0,0 +1,82 @@
+// WordTable.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A WordTable gives each distinct word added to it a small index, in the
+// order the words were first added, so that anything else known about a
+// word (such as how many times it's been seen) can be kept in a vector
+// alongside the table.
+//
+// The table is meant to be cheap even when it's consulted for every word
+// in a large text.  The words themselves are copied end to end into one
+// string, and looked up through an open-addressed hash table of indexes
+// (with linear probing), whose capacity is a power of two and which is
+// never more than half full.  Each word's hash is kept, so that most
+// mismatches are ruled out without comparing text, and so that growing
+// the table never hashes a word again.
+
+#ifndef WORDTABLE_HPP
+#define WORDTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class WordTable
+{
+public:
+    static constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+public:
+    WordTable();
+
+    // insert() returns the word's index, adding the word to the table if
+    // it's not already there, in which case its index is the table's
+    // previous size.
+    std::size_t insert(std::string_view word);
+
+    // find() returns the word's index, or NOT_FOUND if it's not in the
+    // table.
+    std::size_t find(std::string_view word) const;
+
+    // word() returns the word with the given index.  The view remains
+    // valid until another word is added or the table is cleared.
+    std::string_view word(std::size_t index) const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    // clear() removes every word, keeping the memory the table has
+    // allocated so that it can be filled again cheaply.
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::size_t start;
+        std::uint32_t length;
+        std::uint32_t hash;
+    };
+
+    std::string text;
+    std::vector<Entry> entries;
+
+    // Each slot holds one more than the index of the entry it refers to,
+    // so that zero means that it's empty.
+    std::vector<std::uint32_t> slots;
+    std::size_t mask;
+
+private:
+    std::size_t findSlot(std::string_view word, std::uint32_t hash) const;
+    void grow();
+};
+
+
+
+#endif // WORDTABLE_HPP
@@ -0,0 +1,165 @@
+// WorkStealingPool.cpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include "WorkStealingPool.hpp"
+
+
+
+namespace
+{
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+
+    bool takeFront(TaskQueue& queue, std::size_t& task)
+    {
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+
+
+    bool takeBack(TaskQueue& queue, std::size_t& task)
+    {
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+}
+
+
+
+WorkStealingPool::WorkStealingPool(unsigned int threadCount)
+    : threadCount_{std::max(threadCount, 1u)}
+{
+}
+
+
+unsigned int WorkStealingPool::threadCount() const
+{
+    return threadCount_;
+}
+
+
+void WorkStealingPool::run(
+    const std::vector<std::size_t>& costs,
+    const std::function<void(std::size_t)>& task)
+{
+    unsigned int queueCount = static_cast<unsigned int>(
+        std::min<std::size_t>(threadCount_, costs.size()));
+
+    if (queueCount == 0)
+    {
+        return;
+    }
+
+    // Each task, most costly first, goes to the queue with the least work
+    // so far, so each queue ends up ordered from most to least costly.
+    std::vector<std::size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&](std::size_t a, std::size_t b) { return costs[a] > costs[b]; });
+
+    std::unique_ptr<TaskQueue[]> queues{new TaskQueue[queueCount]};
+    std::vector<std::size_t> queuedCosts(queueCount, 0);
+
+    for (std::size_t index : order)
+    {
+        unsigned int lightest = static_cast<unsigned int>(
+            std::min_element(queuedCosts.begin(), queuedCosts.end()) - queuedCosts.begin());
+
+        queues[lightest].tasks.push_back(index);
+        queuedCosts[lightest] += costs[index];
+    }
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+
+    // No tasks are added once the threads start, so a thread that finds
+    // every queue empty has nothing left to do.
+    auto work = [&](unsigned int self)
+    {
+        std::size_t index;
+
+        while (!failed)
+        {
+            bool found = takeFront(queues[self], index);
+
+            for (unsigned int i = 1; !found && i < queueCount; ++i)
+            {
+                found = takeBack(queues[(self + i) % queueCount], index);
+            }
+
+            if (!found)
+            {
+                break;
+            }
+
+            try
+            {
+                task(index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{failureMutex};
+
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
+
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 1; i < queueCount; ++i)
+    {
+        threads.emplace_back(work, i);
+    }
+
+    // The calling thread does its share of the work, too.
+    work(0);
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
@@ -0,0 +1,47 @@
+// WorkStealingPool.hpp
+//
+// ICS 46 Spring 2017
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A WorkStealingPool runs a set of independent tasks on a fixed number of
+// threads.  Each task has an estimated cost (such as the size of the file
+// it processes), and the tasks are dealt out ahead of time, most costly
+// first, so that each thread starts with roughly the same amount of work.
+// Each thread takes tasks from the front of its own queue; when its queue
+// is empty, it steals them from the back of the others', so a thread that
+// was unlucky with its estimates doesn't keep the rest waiting.
+//
+// The tasks are identified by their indexes, and may run in any order,
+// on any of the threads.
+
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+
+
+class WorkStealingPool
+{
+public:
+    WorkStealingPool(unsigned int threadCount);
+
+    unsigned int threadCount() const;
+
+    // run() calls task once for each index from 0 up to (but not
+    // including) costs.size(), returning once every call has returned.
+    // If a task throws an exception, no more tasks are started, and the
+    // first such exception is rethrown once the others have finished.
+    void run(
+        const std::vector<std::size_t>& costs,
+        const std::function<void(std::size_t)>& task);
+
+private:
+    unsigned int threadCount_;
+};
+
+
+
+#endif // WORKSTEALINGPOOL_HPP